@@ -0,0 +1,180 @@
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "parallel_sort.h"
+#include "sort.h"
+
+#define MAX_THREADS 64
+
+struct psort{
+    char *src;
+    char *dst;
+    size_t n;
+    size_t elem_size;
+    int (*cmp)(const void *, const void *); // NULL when sorting ints
+    int stable;
+    int n_threads;
+    int n_runs;
+    size_t bounds[MAX_THREADS + 1]; // run r is [bounds[r], bounds[r+1])
+};
+
+struct psort_job{
+    struct psort *ps;
+    int t;
+};
+
+static void run_threads(struct psort *ps, void *(*fun)(void *)){
+    struct psort_job jobs[MAX_THREADS];
+    pthread_t threads[MAX_THREADS];
+    for(int t = 0; t < ps->n_threads; t++){
+        jobs[t].ps = ps;
+        jobs[t].t = t;
+    }
+    for(int t = 0; t < ps->n_threads; t++){
+        pthread_create(&threads[t], NULL, fun, &jobs[t]);
+    }
+    for(int t = 0; t < ps->n_threads; t++){
+        pthread_join(threads[t], NULL);
+    }
+}
+
+static void sequential_sort(char *base, size_t n, struct psort *ps){
+    if(ps->cmp == NULL){
+        hybrid_sort((int *)base, (int)n);
+    }
+    else if(ps->stable){
+        stable_sort_cmp(base, n, ps->elem_size, ps->cmp);
+    }
+    else{
+        sort_cmp(base, n, ps->elem_size, ps->cmp);
+    }
+}
+
+static void *sort_run_job(void *arg){
+    struct psort_job *job = (struct psort_job *)arg;
+    struct psort *ps = job->ps;
+    size_t lo = ps->bounds[job->t];
+    size_t hi = ps->bounds[job->t + 1];
+    sequential_sort(ps->src + lo * ps->elem_size, hi - lo, ps);
+    return NULL;
+}
+
+static int less_eq(const char *x, const char *y, struct psort *ps){
+    if(ps->cmp == NULL){
+        return *(const int *)x <= *(const int *)y;
+    }
+    return ps->cmp(x, y) <= 0;
+}
+
+// How many of the first k elements of the merge of a and b come from a
+// (ties go to a).
+static size_t co_rank(const char *a, size_t na, const char *b, size_t nb, size_t k, struct psort *ps){
+    size_t es = ps->elem_size;
+    size_t lo = k > nb ? k - nb : 0;
+    size_t hi = k < na ? k : na;
+    while(lo < hi){
+        size_t i = lo + (hi - lo) / 2;
+        size_t j = k - i;
+        // a[i] <= b[j-1]: a[i] is output before b[j-1], so more of a is used
+        if(less_eq(a + i * es, b + (j-1) * es, ps)){
+            lo = i + 1;
+        }
+        else{
+            hi = i;
+        }
+    }
+    return lo;
+}
+
+// Thread t writes elements [n*t/T, n*(t+1)/T) of the next round's output,
+// which may cover the end of one merge and the start of the next.
+static void *merge_job(void *arg){
+    struct psort_job *job = (struct psort_job *)arg;
+    struct psort *ps = job->ps;
+    size_t es = ps->elem_size;
+    size_t lo = ps->n * job->t / ps->n_threads;
+    size_t hi = ps->n * (job->t + 1) / ps->n_threads;
+    for(int r = 0; r < ps->n_runs; r += 2){
+        size_t start = ps->bounds[r];
+        size_t mid = ps->bounds[r+1];
+        size_t end = r + 1 < ps->n_runs ? ps->bounds[r+2] : mid; // a last unpaired run is copied
+        if(end <= lo || start >= hi){
+            continue;
+        }
+        const char *a = ps->src + start * es;
+        const char *b = ps->src + mid * es;
+        size_t k0 = (lo > start ? lo : start) - start;
+        size_t k1 = (hi < end ? hi : end) - start;
+        size_t i0 = co_rank(a, mid - start, b, end - mid, k0, ps);
+        size_t i1 = co_rank(a, mid - start, b, end - mid, k1, ps);
+        size_t j0 = k0 - i0;
+        size_t j1 = k1 - i1;
+        char *out = ps->dst + (start + k0) * es;
+        if(ps->cmp == NULL){
+            merge_int((const int *)a + i0, i1 - i0, (const int *)b + j0, j1 - j0, (int *)out);
+        }
+        else{
+            merge_cmp(a + i0 * es, i1 - i0, b + j0 * es, j1 - j0, out, es, ps->cmp);
+        }
+    }
+    return NULL;
+}
+
+static void sort(char *base, size_t n, size_t elem_size, int (*cmp)(const void *, const void *),
+                 int stable, int n_threads){
+    struct psort ps;
+    ps.n = n;
+    ps.elem_size = elem_size;
+    ps.cmp = cmp;
+    ps.stable = stable;
+    if(n_threads > MAX_THREADS){
+        n_threads = MAX_THREADS;
+    }
+    char *buf = NULL;
+    if(n >= PARALLEL_SORT_MIN && n_threads > 1){
+        buf = (char *)malloc(n * elem_size);
+    }
+    if(buf == NULL){
+        sequential_sort(base, n, &ps);
+        return;
+    }
+
+    ps.src = base;
+    ps.dst = buf;
+    ps.n_threads = n_threads;
+    ps.n_runs = n_threads;
+    for(int t = 0; t <= n_threads; t++){
+        ps.bounds[t] = n * t / n_threads;
+    }
+    run_threads(&ps, sort_run_job);
+    while(ps.n_runs > 1){
+        run_threads(&ps, merge_job);
+        int n_runs = (ps.n_runs + 1) / 2;
+        for(int r = 0; r <= n_runs; r++){
+            ps.bounds[r] = ps.bounds[2*r < ps.n_runs ? 2*r : ps.n_runs];
+        }
+        ps.n_runs = n_runs;
+        char *temp = ps.src;
+        ps.src = ps.dst;
+        ps.dst = temp;
+    }
+    if(ps.src != base){
+        memcpy(base, ps.src, n * elem_size);
+    }
+    free(buf);
+}
+
+void parallel_sort(int l[], int size, int n_threads){
+    if(size < 2){
+        return;
+    }
+    sort((char *)l, size, sizeof(int), NULL, 0, n_threads);
+}
+
+void parallel_sort_cmp(void *base, size_t n, size_t elem_size, int (*cmp)(const void *, const void *),
+                       int stable, int n_threads){
+    if(n < 2 || elem_size == 0){
+        return;
+    }
+    sort((char *)base, n, elem_size, cmp, stable, n_threads);
+}
@@ -0,0 +1,21 @@
+#if !defined(PARALLEL_SORT)
+#define PARALLEL_SORT
+
+#include <stddef.h>
+
+// Parallel merge sort. The array is cut into n_threads runs that are sorted
+// at the same time (with hybrid_sort, or sort_cmp / stable_sort_cmp), then
+// the runs are merged pairwise. Every merge round splits the *output* evenly
+// between the threads, finding each thread's starting point in the two runs
+// by binary search, so all threads do the same amount of work in every round
+// no matter how the runs compare. Needs n elements of extra memory; without it,
+// or below PARALLEL_SORT_MIN elements, the sequential sort is used.
+#define PARALLEL_SORT_MIN 65536
+
+void parallel_sort(int l[], int size, int n_threads);
+
+// stable != 0 keeps equal elements in their original order
+void parallel_sort_cmp(void *base, size_t n, size_t elem_size, int (*cmp)(const void *, const void *),
+                       int stable, int n_threads);
+
+#endif
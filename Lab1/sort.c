@@ -0,0 +1,417 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "sort.h"
+#include "sort_network.h"
+
+void small_sort(int l[], int size){
+    for(int i = 1; i < size; i++){
+        int x = l[i];
+        int j = i;
+        while(j > 0 && l[j-1] > x){
+            l[j] = l[j-1];
+            j--;
+        }
+        l[j] = x;
+    }
+}
+
+static void swap_int(int *a, int *b){
+    int temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+static void sift_down(int l[], int root, int size){
+    int x = l[root];
+    while(2*root + 1 < size){
+        int child = 2*root + 1;
+        if(child + 1 < size && l[child+1] > l[child]){
+            child++;
+        }
+        if(l[child] <= x){
+            break;
+        }
+        l[root] = l[child];
+        root = child;
+    }
+    l[root] = x;
+}
+
+static void heap_sort(int l[], int size){
+    for(int i = size/2 - 1; i >= 0; i--){
+        sift_down(l, i, size);
+    }
+    for(int i = size - 1; i > 0; i--){
+        swap_int(&l[0], &l[i]);
+        sift_down(l, 0, i);
+    }
+}
+
+// small is the size from which on a sorting network or insertion sort
+// finishes the job
+static void intro_rec(int l[], int size, int depth, int small){
+    while(size > small){
+        if(depth == 0){
+            heap_sort(l, size);
+            return;
+        }
+        depth--;
+
+        // after ordering first, middle and last, l[0] <= pivot <= l[size-1]
+        // stop both scans without bounds checks
+        int mid = size / 2;
+        if(l[mid] < l[0]){
+            swap_int(&l[mid], &l[0]);
+        }
+        if(l[size-1] < l[mid]){
+            swap_int(&l[size-1], &l[mid]);
+            if(l[mid] < l[0]){
+                swap_int(&l[mid], &l[0]);
+            }
+        }
+        int pivot = l[mid];
+        int i = 0;
+        int j = size - 1;
+        while(1){
+            // stopping on equal keys keeps the halves even with many duplicates
+            do{
+                i++;
+            } while(l[i] < pivot);
+            do{
+                j--;
+            } while(l[j] > pivot);
+            if(i >= j){
+                break;
+            }
+            swap_int(&l[i], &l[j]);
+        }
+
+        // recurse into the smaller side so the stack stays O(log n)
+        if(i < size - i){
+            intro_rec(l, i, depth, small);
+            l += i;
+            size -= i;
+        }
+        else{
+            intro_rec(l + i, size - i, depth, small);
+            size = i;
+        }
+    }
+    network_sort(l, size);
+}
+
+// largest size handed to network_sort, which is insertion sort without AVX2
+static int small_limit(void){
+    return network_sort_fast() ? NETWORK_MAX : SORT_SMALL;
+}
+
+void intro_sort(int l[], int size){
+    int depth = 0;
+    for(int n = size; n > 1; n >>= 1){
+        depth += 2;
+    }
+    intro_rec(l, size, depth, small_limit());
+}
+
+int radix_sort(int l[], int size){
+    if(size < 2){
+        return 1;
+    }
+    uint32_t *tmp = (uint32_t *)malloc(size * sizeof(uint32_t));
+    if(tmp == NULL){
+        return 0;
+    }
+    // one pass to count all four bytes; flipping the sign bit makes the
+    // unsigned order of the top byte match the signed order
+    uint32_t (*count)[256] = (uint32_t (*)[256])calloc(4, sizeof(*count));
+    if(count == NULL){
+        free(tmp);
+        return 0;
+    }
+    uint32_t *src = (uint32_t *)l;
+    for(int i = 0; i < size; i++){
+        uint32_t u = src[i] ^ 0x80000000u;
+        count[0][u & 255]++;
+        count[1][(u >> 8) & 255]++;
+        count[2][(u >> 16) & 255]++;
+        count[3][u >> 24]++;
+    }
+
+    uint32_t *dst = tmp;
+    for(int b = 0; b < 4; b++){
+        int shift = 8 * b;
+        uint32_t first = ((src[0] ^ 0x80000000u) >> shift) & 255;
+        if(count[b][first] == (uint32_t)size){
+            continue; // every key has the same byte here
+        }
+        uint32_t pos = 0;
+        for(int d = 0; d < 256; d++){
+            uint32_t c = count[b][d];
+            count[b][d] = pos;
+            pos += c;
+        }
+        for(int i = 0; i < size; i++){
+            uint32_t d = ((src[i] ^ 0x80000000u) >> shift) & 255;
+            dst[count[b][d]++] = src[i];
+        }
+        uint32_t *temp = src;
+        src = dst;
+        dst = temp;
+    }
+    if(src != (uint32_t *)l){
+        memcpy(l, src, size * sizeof(int));
+    }
+    free(count);
+    free(tmp);
+    return 1;
+}
+
+void merge_int(const int a[], size_t na, const int b[], size_t nb, int out[]){
+    size_t i = 0;
+    size_t j = 0;
+    size_t k = 0;
+    while(i < na && j < nb){
+        // no branch on which side wins: it is a coin flip on random input
+        int take_b = b[j] < a[i];
+        out[k++] = take_b ? b[j] : a[i];
+        j += take_b;
+        i += !take_b;
+    }
+    memcpy(out + k, a + i, (na - i) * sizeof(int));
+    memcpy(out + k + (na - i), b + j, (nb - j) * sizeof(int));
+}
+
+// 1 if l was already in order (reversing it first if it was descending)
+static int presorted(int l[], int size){
+    int i = 1;
+    while(i < size && l[i-1] <= l[i]){
+        i++;
+    }
+    if(i == size){
+        return 1;
+    }
+    if(i > 1){
+        return 0;
+    }
+    while(i < size && l[i-1] >= l[i]){
+        i++;
+    }
+    if(i < size){
+        return 0;
+    }
+    for(int a = 0, b = size - 1; a < b; a++, b--){
+        swap_int(&l[a], &l[b]);
+    }
+    return 1;
+}
+
+void hybrid_sort(int l[], int size){
+    if(size <= small_limit()){
+        network_sort(l, size);
+        return;
+    }
+    if(presorted(l, size)){
+        return;
+    }
+    if(size >= SORT_RADIX_MIN && radix_sort(l, size)){
+        return;
+    }
+    intro_sort(l, size);
+}
+
+/***************************************************************************/
+
+// Generic version: the same algorithm on elem_size-byte elements through cmp.
+
+static void swap_bytes(char *a, char *b, size_t n){
+    while(n >= 8){
+        uint64_t x, y;
+        memcpy(&x, a, 8);
+        memcpy(&y, b, 8);
+        memcpy(a, &y, 8);
+        memcpy(b, &x, 8);
+        a += 8;
+        b += 8;
+        n -= 8;
+    }
+    while(n > 0){
+        char c = *a;
+        *a++ = *b;
+        *b++ = c;
+        n--;
+    }
+}
+
+struct sort_ctx{
+    size_t elem_size;
+    int (*cmp)(const void *, const void *);
+    char *temp; // room for one element
+};
+
+#define AT(base, i) ((base) + (size_t)(i) * ctx->elem_size)
+
+static void small_sort_cmp(char *base, size_t n, struct sort_ctx *ctx){
+    size_t es = ctx->elem_size;
+    for(size_t i = 1; i < n; i++){
+        size_t j = i;
+        while(j > 0 && ctx->cmp(AT(base, j-1), AT(base, i)) > 0){
+            j--;
+        }
+        if(j < i){
+            memcpy(ctx->temp, AT(base, i), es);
+            memmove(AT(base, j+1), AT(base, j), (i - j) * es);
+            memcpy(AT(base, j), ctx->temp, es);
+        }
+    }
+}
+
+static void sift_down_cmp(char *base, size_t root, size_t n, struct sort_ctx *ctx){
+    while(2*root + 1 < n){
+        size_t child = 2*root + 1;
+        if(child + 1 < n && ctx->cmp(AT(base, child+1), AT(base, child)) > 0){
+            child++;
+        }
+        if(ctx->cmp(AT(base, child), AT(base, root)) <= 0){
+            break;
+        }
+        swap_bytes(AT(base, root), AT(base, child), ctx->elem_size);
+        root = child;
+    }
+}
+
+static void heap_sort_cmp(char *base, size_t n, struct sort_ctx *ctx){
+    for(size_t i = n/2; i > 0; i--){
+        sift_down_cmp(base, i - 1, n, ctx);
+    }
+    for(size_t i = n - 1; i > 0; i--){
+        swap_bytes(AT(base, 0), AT(base, i), ctx->elem_size);
+        sift_down_cmp(base, 0, i, ctx);
+    }
+}
+
+static void intro_rec_cmp(char *base, size_t n, int depth, struct sort_ctx *ctx){
+    size_t es = ctx->elem_size;
+    while(n > SORT_SMALL){
+        if(depth == 0){
+            heap_sort_cmp(base, n, ctx);
+            return;
+        }
+        depth--;
+
+        size_t mid = n / 2;
+        if(ctx->cmp(AT(base, mid), AT(base, 0)) < 0){
+            swap_bytes(AT(base, mid), AT(base, 0), es);
+        }
+        if(ctx->cmp(AT(base, n-1), AT(base, mid)) < 0){
+            swap_bytes(AT(base, n-1), AT(base, mid), es);
+            if(ctx->cmp(AT(base, mid), AT(base, 0)) < 0){
+                swap_bytes(AT(base, mid), AT(base, 0), es);
+            }
+        }
+        // the pivot is copied out as the partition moves elements around
+        memcpy(ctx->temp, AT(base, mid), es);
+        size_t i = 0;
+        size_t j = n - 1;
+        while(1){
+            do{
+                i++;
+            } while(ctx->cmp(AT(base, i), ctx->temp) < 0);
+            do{
+                j--;
+            } while(ctx->cmp(AT(base, j), ctx->temp) > 0);
+            if(i >= j){
+                break;
+            }
+            swap_bytes(AT(base, i), AT(base, j), es);
+        }
+
+        if(i < n - i){
+            intro_rec_cmp(base, i, depth, ctx);
+            base = AT(base, i);
+            n -= i;
+        }
+        else{
+            intro_rec_cmp(AT(base, i), n - i, depth, ctx);
+            n = i;
+        }
+    }
+    small_sort_cmp(base, n, ctx);
+}
+
+void sort_cmp(void *base, size_t n, size_t elem_size, int (*cmp)(const void *, const void *)){
+    if(n < 2 || elem_size == 0){
+        return;
+    }
+    struct sort_ctx ctx;
+    ctx.elem_size = elem_size;
+    ctx.cmp = cmp;
+    ctx.temp = (char *)malloc(elem_size);
+    int depth = 0;
+    for(size_t k = n; k > 1; k >>= 1){
+        depth += 2;
+    }
+    intro_rec_cmp((char *)base, n, depth, &ctx);
+    free(ctx.temp);
+}
+
+void merge_cmp(const void *a, size_t na, const void *b, size_t nb, void *out,
+               size_t elem_size, int (*cmp)(const void *, const void *)){
+    const char *pa = (const char *)a;
+    const char *pb = (const char *)b;
+    const char *end_a = pa + na * elem_size;
+    const char *end_b = pb + nb * elem_size;
+    char *po = (char *)out;
+    while(pa < end_a && pb < end_b){
+        if(cmp(pb, pa) < 0){
+            memcpy(po, pb, elem_size);
+            pb += elem_size;
+        }
+        else{
+            memcpy(po, pa, elem_size);
+            pa += elem_size;
+        }
+        po += elem_size;
+    }
+    memcpy(po, pa, end_a - pa);
+    memcpy(po + (end_a - pa), pb, end_b - pb);
+}
+
+void stable_sort_cmp(void *base, size_t n, size_t elem_size, int (*cmp)(const void *, const void *)){
+    if(n < 2 || elem_size == 0){
+        return;
+    }
+    struct sort_ctx ctx;
+    ctx.elem_size = elem_size;
+    ctx.cmp = cmp;
+    ctx.temp = (char *)malloc(elem_size);
+    char *buf = (char *)malloc(n * elem_size);
+    if(buf == NULL){
+        // insertion sort is stable too, just slow
+        small_sort_cmp((char *)base, n, &ctx);
+        free(ctx.temp);
+        return;
+    }
+
+    char *src = (char *)base;
+    char *dst = buf;
+    for(size_t i = 0; i < n; i += SORT_SMALL){
+        small_sort_cmp(src + i * elem_size, n - i < SORT_SMALL ? n - i : SORT_SMALL, &ctx);
+    }
+    for(size_t width = SORT_SMALL; width < n; width *= 2){
+        for(size_t lo = 0; lo < n; lo += 2 * width){
+            size_t mid = lo + width < n ? lo + width : n;
+            size_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+            merge_cmp(src + lo * elem_size, mid - lo, src + mid * elem_size, hi - mid,
+                      dst + lo * elem_size, elem_size, cmp);
+        }
+        char *temp = src;
+        src = dst;
+        dst = temp;
+    }
+    if(src != (char *)base){
+        memcpy(base, src, n * elem_size);
+    }
+    free(buf);
+    free(ctx.temp);
+}
@@ -0,0 +1,38 @@
+#if !defined(SORT)
+#define SORT
+
+#include <stddef.h>
+
+// Replacement for insertion_sort from lab1.c with the same signature. Picks
+// the algorithm by size:
+//   size <= NETWORK_MAX      sorting network (sort_network.h), or insertion
+//                            sort up to SORT_SMALL without AVX2
+//   size <  SORT_RADIX_MIN   introsort: quicksort on the median of three,
+//                            heapsort if the recursion gets too deep, with
+//                            the small pieces finished as above
+//   otherwise                LSD radix sort, one pass per byte
+// Input that is already sorted or reversed is noticed and handled in O(n).
+#define SORT_SMALL 16
+#define SORT_RADIX_MIN 256
+
+void hybrid_sort(int l[], int size);
+
+// the pieces, for benchmarking
+void small_sort(int l[], int size);
+void intro_sort(int l[], int size);
+int radix_sort(int l[], int size); // returns 0 (and leaves l alone) if out of memory
+
+// introsort for any element type, with the same arguments as qsort
+void sort_cmp(void *base, size_t n, size_t elem_size, int (*cmp)(const void *, const void *));
+
+// merge sort: slower, needs n elements of extra memory, but keeps equal
+// elements in their original order
+void stable_sort_cmp(void *base, size_t n, size_t elem_size, int (*cmp)(const void *, const void *));
+
+// merge two sorted runs into out (which must not overlap them); on ties the
+// element from a comes first
+void merge_int(const int a[], size_t na, const int b[], size_t nb, int out[]);
+void merge_cmp(const void *a, size_t na, const void *b, size_t nb, void *out,
+               size_t elem_size, int (*cmp)(const void *, const void *));
+
+#endif
@@ -0,0 +1,108 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sort.h"
+
+// Times insertion_sort from lab1.c (copied below, up to 10^5 elements), qsort,
+// sort_cmp and hybrid_sort on random, sorted, reversed and few-unique arrays
+// of 10 to 10^8 ints. Prints ns per element; each measurement is repeated
+// until it has sorted 10^7 elements or taken MIN_SECS. Below BATCH elements
+// a single sort is too short for clock(), so batches of sorts are timed
+// together with the copies that reset the input.
+
+#define MAX_N 100000000
+#define INSERTION_MAX 100000
+#define MIN_WORK 10000000
+#define MIN_SECS 0.2
+#define BATCH 10000
+
+void insertion_sort(int l[], int size){
+    int i = 1;
+    while(i < size){
+        int j = i;
+        while(j > 0 && l[j-1] > l[j]){
+            int temp = l[j];
+            l[j] = l[j-1];
+            l[j-1] = temp;
+            j--;
+        }
+        i++;
+    }
+}
+
+static int cmp_int(const void *a, const void *b){
+    int x = *(const int *)a;
+    int y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static void run_qsort(int l[], int size){
+    qsort(l, size, sizeof(int), cmp_int);
+}
+
+static void run_sort_cmp(int l[], int size){
+    sort_cmp(l, size, sizeof(int), cmp_int);
+}
+
+static void fill(int l[], int n, int kind){
+    for(int i = 0; i < n; i++){
+        switch(kind){
+            case 0: l[i] = rand() - rand(); break;
+            case 1: l[i] = i; break;
+            case 2: l[i] = n - i; break;
+            default: l[i] = rand() % 16; break;
+        }
+    }
+}
+
+static double time_sort(void (*sort)(int *, int), int *l, const int *orig, int n){
+    int batch = n < BATCH ? BATCH / n : 1;
+    long long done = 0;
+    int reps = 0;
+    double secs = 0;
+    while(done < MIN_WORK && secs < MIN_SECS){
+        if(batch == 1){
+            memcpy(l, orig, n * sizeof(int));
+        }
+        clock_t start = clock();
+        for(int b = 0; b < batch; b++){
+            if(batch > 1){
+                memcpy(l, orig, n * sizeof(int));
+            }
+            sort(l, n);
+        }
+        secs += (double)(clock() - start) / CLOCKS_PER_SEC;
+        done += (long long)n * batch;
+        reps += batch;
+    }
+    return secs / reps / n * 1e9;
+}
+
+int main(int argc, char *argv[]){
+    const char *kinds[] = {"random", "sorted", "reversed", "few-unique"};
+    int max_n = argc > 1 ? atoi(argv[1]) : MAX_N;
+    int *orig = (int *)malloc((size_t)max_n * sizeof(int));
+    int *l = (int *)malloc((size_t)max_n * sizeof(int));
+    srand(1);
+    printf("%-11s %10s %10s %10s %10s %10s   (ns/element)\n", "input", "n", "insertion", "qsort", "sort_cmp", "hybrid");
+    for(int kind = 0; kind < 4; kind++){
+        for(int n = 10; n <= max_n; n *= 10){
+            fill(orig, n, kind);
+            printf("%-11s %10d ", kinds[kind], n);
+            if(n <= INSERTION_MAX){
+                printf("%10.2f ", time_sort(insertion_sort, l, orig, n));
+            }
+            else{
+                printf("%10s ", "-");
+            }
+            printf("%10.2f ", time_sort(run_qsort, l, orig, n));
+            printf("%10.2f ", time_sort(run_sort_cmp, l, orig, n));
+            printf("%10.2f\n", time_sort(hybrid_sort, l, orig, n));
+            fflush(stdout);
+        }
+    }
+    free(orig);
+    free(l);
+    return 0;
+}
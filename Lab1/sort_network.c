@@ -0,0 +1,224 @@
+#include <limits.h>
+#include "sort_network.h"
+#include "sort.h"
+#if defined(__x86_64__) || defined(__i386__)
+#define HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(HAVE_X86)
+
+#define AVX2_INLINE __attribute__((target("avx2"), always_inline)) static inline
+
+// One comparator step inside a register: lane i ends up with the min or the
+// max of itself and its partner p (lane i^d), the max where bit i of mask is 1.
+#define STEP(v, p, mask) _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), mask)
+
+AVX2_INLINE __m256i swap1(__m256i v){
+    return _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+AVX2_INLINE __m256i swap2(__m256i v){
+    return _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+AVX2_INLINE __m256i swap4(__m256i v){
+    return _mm256_permute2x128_si256(v, v, 1);
+}
+
+AVX2_INLINE __m256i reverse8(__m256i v){
+    return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0));
+}
+
+// sorts a bitonic register
+AVX2_INLINE __m256i merge8(__m256i v){
+    v = STEP(v, swap4(v), 0xF0);
+    v = STEP(v, swap2(v), 0xCC);
+    v = STEP(v, swap1(v), 0xAA);
+    return v;
+}
+
+// bitonic sort of one register: sorted pairs, then quads, then all 8
+AVX2_INLINE __m256i sort8(__m256i v){
+    v = STEP(v, swap1(v), 0x66);
+    v = STEP(v, swap2(v), 0x3C);
+    v = STEP(v, swap1(v), 0x5A);
+    return merge8(v);
+}
+
+AVX2_INLINE void min_max(__m256i *a, __m256i *b){
+    __m256i lo = _mm256_min_epi32(*a, *b);
+    *b = _mm256_max_epi32(*a, *b);
+    *a = lo;
+}
+
+// r[0..2w) holds two sorted runs of w registers; leaves one sorted run
+AVX2_INLINE void merge_runs(__m256i *r, int w){
+    // the first run followed by the second one reversed is bitonic
+    for(int i = 0; i < w/2; i++){
+        __m256i temp = r[w + i];
+        r[w + i] = r[2*w - 1 - i];
+        r[2*w - 1 - i] = temp;
+    }
+    for(int i = w; i < 2*w; i++){
+        r[i] = reverse8(r[i]);
+    }
+    for(int dist = w; dist >= 1; dist /= 2){
+        for(int i = 0; i < 2*w; i++){
+            if((i & dist) == 0){
+                min_max(&r[i], &r[i + dist]);
+            }
+        }
+    }
+    for(int i = 0; i < 2*w; i++){
+        r[i] = merge8(r[i]);
+    }
+}
+
+// n_regs is a constant at every call, so the loops unroll and r stays in
+// registers
+AVX2_INLINE void sort_regs(__m256i *r, int n_regs){
+    for(int i = 0; i < n_regs; i++){
+        r[i] = sort8(r[i]);
+    }
+    for(int w = 1; w < n_regs; w *= 2){
+        for(int g = 0; g < n_regs; g += 2*w){
+            merge_runs(r + g, w);
+        }
+    }
+}
+
+// lanes i with i < n are set
+AVX2_INLINE __m256i first_lanes(int n){
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(n), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+}
+
+// loads l[0..n) (n may be <= 0) padded with INT_MAX, without reading past it
+AVX2_INLINE __m256i load_padded(const int *l, __m256i mask){
+    return _mm256_blendv_epi8(_mm256_set1_epi32(INT_MAX), _mm256_maskload_epi32(l, mask), mask);
+}
+
+__attribute__((target("avx2")))
+static void network_sort_avx2(int l[], int size){
+    __m256i r[8];
+    __m256i mask[8];
+    int n_regs = size <= 8 ? 1 : size <= 16 ? 2 : size <= 32 ? 4 : 8;
+    for(int i = 0; i < n_regs; i++){
+        mask[i] = first_lanes(size - 8*i);
+        r[i] = load_padded(l + 8*i, mask[i]);
+    }
+    switch(n_regs){
+        case 1: r[0] = sort8(r[0]); break;
+        case 2: sort_regs(r, 2); break;
+        case 4: sort_regs(r, 4); break;
+        default: sort_regs(r, 8); break;
+    }
+    for(int i = 0; i < n_regs; i++){
+        _mm256_maskstore_epi32(l + 8*i, mask[i], r[i]);
+    }
+}
+
+// r[i] lane j <-> r[j] lane i
+AVX2_INLINE void transpose8(__m256i *r){
+    __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+    __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+    __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+    __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+    __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+    __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+    __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+    __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+    __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+    __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+    __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+    __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+    __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+    __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+    __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+    __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+    r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+    r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+    r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+    r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+    r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+    r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+    r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+    r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// the optimal 19-comparator network for 8 inputs, applied lane by lane
+AVX2_INLINE void network8_columns(__m256i *r){
+    min_max(&r[0], &r[1]); min_max(&r[2], &r[3]); min_max(&r[4], &r[5]); min_max(&r[6], &r[7]);
+    min_max(&r[0], &r[2]); min_max(&r[1], &r[3]); min_max(&r[4], &r[6]); min_max(&r[5], &r[7]);
+    min_max(&r[1], &r[2]); min_max(&r[5], &r[6]); min_max(&r[0], &r[4]); min_max(&r[3], &r[7]);
+    min_max(&r[1], &r[5]); min_max(&r[2], &r[6]);
+    min_max(&r[1], &r[4]); min_max(&r[3], &r[6]);
+    min_max(&r[2], &r[4]); min_max(&r[3], &r[5]);
+    min_max(&r[3], &r[4]);
+}
+
+__attribute__((target("avx2")))
+static void network_sort_batch_avx2(int l[], int n_arrays, int size){
+    int a = 0;
+    if(size <= 8){
+        __m256i mask = first_lanes(size);
+        for(; a + 8 <= n_arrays; a += 8){
+            int *base = l + (long)a * size;
+            __m256i r[8];
+            for(int j = 0; j < 8; j++){
+                r[j] = load_padded(base + j*size, mask);
+            }
+            transpose8(r);
+            network8_columns(r);
+            transpose8(r);
+            for(int j = 0; j < 8; j++){
+                _mm256_maskstore_epi32(base + j*size, mask, r[j]);
+            }
+        }
+    }
+    for(; a < n_arrays; a++){
+        network_sort_avx2(l + (long)a * size, size);
+    }
+}
+
+static int have_avx2 = -1;
+
+static int check_avx2(void){
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") ? 1 : 0;
+}
+
+#endif
+
+int network_sort_fast(void){
+#if defined(HAVE_X86)
+    if(have_avx2 < 0){
+        have_avx2 = check_avx2();
+    }
+    return have_avx2;
+#else
+    return 0;
+#endif
+}
+
+void network_sort(int l[], int size){
+#if defined(HAVE_X86)
+    if(network_sort_fast()){
+        network_sort_avx2(l, size);
+        return;
+    }
+#endif
+    small_sort(l, size);
+}
+
+void network_sort_batch(int l[], int n_arrays, int size){
+#if defined(HAVE_X86)
+    if(network_sort_fast()){
+        network_sort_batch_avx2(l, n_arrays, size);
+        return;
+    }
+#endif
+    for(int a = 0; a < n_arrays; a++){
+        small_sort(l + (long)a * size, size);
+    }
+}
@@ -0,0 +1,22 @@
+#if !defined(SORT_NETWORK)
+#define SORT_NETWORK
+
+// Branch-free sorting of small int arrays with AVX2. An array is padded with
+// INT_MAX up to 8, 16, 32 or 64 elements, each group of 8 is sorted inside one
+// register and the registers are then combined with bitonic merges, so the
+// work depends only on the size and never on the values. Without AVX2 (checked
+// on the first call) small_sort from sort.c is used instead.
+#define NETWORK_MAX 64
+
+// size <= NETWORK_MAX
+void network_sort(int l[], int size);
+
+// 1 if network_sort has AVX2 (and is not just insertion sort)
+int network_sort_fast(void);
+
+// Sorts n_arrays arrays of size ints stored one after another. For size <= 8,
+// 8 arrays at a time are transposed so that each register holds one position
+// of 8 arrays, and a single 19-comparator network sorts all 8 together.
+void network_sort_batch(int l[], int n_arrays, int size);
+
+#endif
@@ -0,0 +1,79 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sort.h"
+#include "sort_network.h"
+
+// Sorts 10^5 small random arrays of each size with insertion_sort from lab1.c
+// (copied below), small_sort, network_sort one array at a time and
+// network_sort_batch. Prints ns per array (best of ROUNDS).
+
+#define N_ARRAYS 100000
+#define ROUNDS 5
+
+void insertion_sort(int l[], int size){
+    int i = 1;
+    while(i < size){
+        int j = i;
+        while(j > 0 && l[j-1] > l[j]){
+            int temp = l[j];
+            l[j] = l[j-1];
+            l[j-1] = temp;
+            j--;
+        }
+        i++;
+    }
+}
+
+int main(){
+    int sizes[] = {4, 7, 8, 12, 16, 24, 32, 48, 64};
+    const char *names[] = {"insertion", "small_sort", "network", "batch"};
+    printf("%4s", "size");
+    for(int w = 0; w < 4; w++){
+        printf(" %10s", names[w]);
+    }
+    printf("   (ns per array)\n");
+    srand(1);
+    for(int s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++){
+        int n = sizes[s];
+        int *orig = (int *)malloc(N_ARRAYS * n * sizeof(int));
+        int *l = (int *)malloc(N_ARRAYS * n * sizeof(int));
+        for(int i = 0; i < N_ARRAYS * n; i++){
+            orig[i] = rand();
+        }
+        printf("%4d", n);
+        for(int w = 0; w < 4; w++){
+            double best = 1e30;
+            for(int r = 0; r < ROUNDS; r++){
+                memcpy(l, orig, N_ARRAYS * n * sizeof(int));
+                clock_t start = clock();
+                if(w == 3){
+                    network_sort_batch(l, N_ARRAYS, n);
+                }
+                else{
+                    for(int a = 0; a < N_ARRAYS; a++){
+                        if(w == 0){
+                            insertion_sort(l + a*n, n);
+                        }
+                        else if(w == 1){
+                            small_sort(l + a*n, n);
+                        }
+                        else{
+                            network_sort(l + a*n, n);
+                        }
+                    }
+                }
+                double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+                if(secs < best){
+                    best = secs;
+                }
+            }
+            printf(" %10.1f", best / N_ARRAYS * 1e9);
+        }
+        printf("\n");
+        free(orig);
+        free(l);
+    }
+    return 0;
+}
@@ -0,0 +1,222 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sorted_array.h"
+#include "sort.h"
+#include "sort_network.h"
+#include "../Lab4/search.h"
+
+#define MAX_RUNS 85 // run lengths on the stack grow at least like Fibonacci numbers
+
+// search_upper that looks at l[n-1], l[n-2], l[n-4], ... first, so it costs
+// O(log d) when the answer is d from the end
+static int gallop_upper(const int l[], int n, int x){
+    int lo = 0;
+    int hi = n;
+    for(int step = 1; n - step >= 0; step *= 2){
+        if(l[n - step] <= x){
+            lo = n - step + 1;
+            break;
+        }
+        hi = n - step;
+    }
+    return lo + (int)search_upper(l + lo, hi - lo, x);
+}
+
+void sorted_init(struct sorted_array *a){
+    a->data = NULL;
+    a->size = 0;
+    a->capacity = 0;
+}
+
+void sorted_free(struct sorted_array *a){
+    free(a->data);
+    sorted_init(a);
+}
+
+static int reserve(struct sorted_array *a, int size){
+    if(size <= a->capacity){
+        return 1;
+    }
+    int capacity = a->capacity > 0 ? a->capacity : 16;
+    while(capacity < size){
+        capacity *= 2;
+    }
+    int *data = (int *)realloc(a->data, capacity * sizeof(int));
+    if(data == NULL){
+        printf("Error: Out of memory!\n");
+        return 0;
+    }
+    a->data = data;
+    a->capacity = capacity;
+    return 1;
+}
+
+void sorted_insert(struct sorted_array *a, int x){
+    if(!reserve(a, a->size + 1)){
+        return;
+    }
+    int pos = gallop_upper(a->data, a->size, x);
+    memmove(a->data + pos + 1, a->data + pos, (a->size - pos) * sizeof(int));
+    a->data[pos] = x;
+    a->size++;
+}
+
+void sorted_insert_batch(struct sorted_array *a, int batch[], int n){
+    if(n <= 0 || !reserve(a, a->size + n)){
+        return;
+    }
+    adaptive_sort(batch, n);
+    // From the largest new element down: the old elements above it move up
+    // by the number of new elements still to place, in one memmove.
+    int i = a->size; // a->data[0..i) is still unmoved
+    for(int j = n - 1; j >= 0; j--){
+        int pos = gallop_upper(a->data, i, batch[j]);
+        memmove(a->data + pos + j + 1, a->data + pos, (i - pos) * sizeof(int));
+        a->data[pos + j] = batch[j];
+        i = pos;
+    }
+    a->size += n;
+}
+
+/***************************************************************************/
+
+struct run{
+    int start;
+    int length;
+};
+
+// end of the run starting at lo; a strictly descending run is reversed
+// (strictly, so that equal elements never swap places)
+static int find_run(int l[], int lo, int hi){
+    int i = lo + 1;
+    if(i == hi){
+        return hi;
+    }
+    if(l[i] < l[lo]){
+        while(i + 1 < hi && l[i+1] < l[i]){
+            i++;
+        }
+        for(int a = lo, b = i; a < b; a++, b--){
+            int temp = l[a];
+            l[a] = l[b];
+            l[b] = temp;
+        }
+    }
+    else{
+        while(i + 1 < hi && l[i+1] >= l[i]){
+            i++;
+        }
+    }
+    return i + 1;
+}
+
+// merges the sorted neighbours l[lo..mid) and l[mid..hi) using tmp
+static void merge_neighbours(int l[], int lo, int mid, int hi, int *tmp){
+    // the start of the left run that is <= l[mid] and the end of the right
+    // run that is >= l[mid-1] are already in place
+    lo += (int)search_upper(l + lo, mid - lo, l[mid]);
+    hi = mid + (int)search_lower(l + mid, hi - mid, l[mid-1]);
+    if(lo == mid || mid == hi){
+        return;
+    }
+    // After the trimming the last element of the left run is the largest of
+    // all and the first of the right run the smallest, so the front half of
+    // the output can only run out of right elements and the back half only
+    // out of left ones. Both halves are merged in the same loop, which gives
+    // the CPU two independent chains of compare-and-advance; the runs are
+    // copied out first so that neither half reads what the other has written.
+    int na = mid - lo;
+    int nb = hi - mid;
+    const int *a = tmp;
+    const int *b = tmp + na;
+    int *out = l + lo;
+    memcpy(tmp, out, (na + nb) * sizeof(int));
+    int half = (na + nb) / 2;
+    int i = 0, j = 0, k = 0;                        // front, forwards
+    int bi = na - 1, bj = nb - 1, bk = na + nb - 1; // back, backwards
+    while(k < half && j < nb && bi >= 0){
+        int take_b = b[j] < a[i];
+        out[k++] = take_b ? b[j] : a[i];
+        j += take_b;
+        i += !take_b;
+        int take_a = a[bi] > b[bj];
+        out[bk--] = take_a ? a[bi] : b[bj];
+        bi -= take_a;
+        bj -= !take_a;
+    }
+    while(k < half){
+        int take_b = j < nb && b[j] < a[i];
+        out[k++] = take_b ? b[j] : a[i];
+        j += take_b;
+        i += !take_b;
+    }
+    while(bk >= half){
+        int take_a = bi >= 0 && a[bi] > b[bj];
+        out[bk--] = take_a ? a[bi] : b[bj];
+        bi -= take_a;
+        bj -= !take_a;
+    }
+}
+
+static void merge_at(int l[], struct run *runs, int at, int n_runs, int *tmp){
+    struct run *a = &runs[at];
+    struct run *b = &runs[at + 1];
+    merge_neighbours(l, a->start, b->start, b->start + b->length, tmp);
+    a->length += b->length;
+    if(at + 2 < n_runs){
+        runs[at + 1] = runs[at + 2];
+    }
+}
+
+// Merges until the run lengths on the stack satisfy Timsort's rules
+// (each run longer than the two above it together, and than the one above),
+// which keeps every merge between runs of similar size.
+static int merge_collapse(int l[], struct run *runs, int n_runs, int *tmp){
+    while(n_runs > 1){
+        int n = n_runs - 2;
+        if((n > 0 && runs[n-1].length <= runs[n].length + runs[n+1].length)
+           || (n > 1 && runs[n-2].length <= runs[n-1].length + runs[n].length)){
+            if(runs[n-1].length < runs[n+1].length){
+                n--;
+            }
+        }
+        else if(runs[n].length > runs[n+1].length){
+            break;
+        }
+        merge_at(l, runs, n, n_runs, tmp);
+        n_runs--;
+    }
+    return n_runs;
+}
+
+void adaptive_sort(int l[], int size){
+    if(size < 2){
+        return;
+    }
+    int *tmp = (int *)malloc(size * sizeof(int));
+    if(tmp == NULL){
+        hybrid_sort(l, size);
+        return;
+    }
+    struct run runs[MAX_RUNS];
+    int n_runs = 0;
+    int lo = 0;
+    while(lo < size){
+        int end = find_run(l, lo, size);
+        if(end - lo < ADAPTIVE_MIN_RUN){
+            // equal ints cannot be told apart, so this needs no stability
+            end = size - lo < ADAPTIVE_MIN_RUN ? size : lo + ADAPTIVE_MIN_RUN;
+            network_sort(l + lo, end - lo);
+        }
+        runs[n_runs].start = lo;
+        runs[n_runs].length = end - lo;
+        n_runs = merge_collapse(l, runs, n_runs + 1, tmp);
+        lo = end;
+    }
+    while(n_runs > 1){
+        merge_at(l, runs, n_runs - 2, n_runs, tmp);
+        n_runs--;
+    }
+    free(tmp);
+}
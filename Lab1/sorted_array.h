@@ -0,0 +1,36 @@
+#if !defined(SORTED_ARRAY)
+#define SORTED_ARRAY
+
+// An int array kept in increasing order as elements arrive, for streams that
+// are nearly sorted already. Where insertion_sort in lab1.c walks to the
+// insertion point one swap at a time, sorted_insert finds it with the
+// branch-free search_upper from Lab4/search.h and opens the gap with one
+// memmove. The search starts by doubling its way back from the end, so an
+// element d places from the end costs O(log d) comparisons. Batches are
+// sorted with adaptive_sort and then merged in from the back, so every old
+// element moves at most once per batch.
+
+struct sorted_array{
+    int *data;
+    int size;
+    int capacity;
+};
+
+void sorted_init(struct sorted_array *a);
+void sorted_free(struct sorted_array *a);
+
+void sorted_insert(struct sorted_array *a, int x);
+
+// adds batch[0..n) (which gets sorted in place)
+void sorted_insert_batch(struct sorted_array *a, int batch[], int n);
+
+// Natural merge sort in the style of Timsort: finds the ascending (or strictly
+// descending, then reversed) runs already in l, sorts ADAPTIVE_MIN_RUN
+// elements with network_sort wherever a run is shorter than that, and merges
+// runs of similar length, skipping the parts of each pair that are already in
+// place. O(n) on sorted input and O(n log n) at worst. Must not exceed
+// NETWORK_MAX.
+#define ADAPTIVE_MIN_RUN 64
+void adaptive_sort(int l[], int size);
+
+#endif
@@ -0,0 +1,221 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sort.h"
+#include "sorted_array.h"
+
+// Keeps a sorted array of BASE ints up to date as new elements arrive.
+// 1) N_SINGLE elements one at a time: swapping each new element down from
+//    the end as insertion_sort in lab1.c does, against sorted_insert.
+// 2) N_BATCHES batches of BATCH elements: appending the batch and rerunning
+//    insertion_sort or hybrid_sort on everything, against sorted_insert_batch.
+// 3) adaptive_sort against hybrid_sort on whole arrays with some order in them.
+// Each case runs with "nearly sorted" arrivals (values a little above the
+// current maximum, slightly shuffled) and with random ones.
+
+#define BASE 1000000
+#define N_SINGLE 20000
+#define BATCH 1000
+#define N_BATCHES 50
+
+void insertion_sort(int l[], int size){
+    int i = 1;
+    while(i < size){
+        int j = i;
+        while(j > 0 && l[j-1] > l[j]){
+            int temp = l[j];
+            l[j] = l[j-1];
+            l[j-1] = temp;
+            j--;
+        }
+        i++;
+    }
+}
+
+// the last step of insertion_sort: l[0..size-1) is sorted
+void insert_last(int l[], int size){
+    int j = size - 1;
+    while(j > 0 && l[j-1] > l[j]){
+        int temp = l[j];
+        l[j] = l[j-1];
+        l[j-1] = temp;
+        j--;
+    }
+}
+
+// value i of a growing stream, close to 4*i but up to 64 away
+int nearly(int i){
+    return 4 * i + rand() % 128 - 64;
+}
+
+void fill_base(int l[]){
+    for(int i = 0; i < BASE; i++){
+        l[i] = 4 * i;
+    }
+}
+
+int *make_arrivals(int n, int random){
+    int *v = (int *)malloc(n * sizeof(int));
+    for(int i = 0; i < n; i++){
+        v[i] = random ? rand() % (4 * BASE) : nearly(BASE + i);
+    }
+    return v;
+}
+
+int check(const int l[], int size){
+    for(int i = 1; i < size; i++){
+        if(l[i-1] > l[i]){
+            return 0;
+        }
+    }
+    return 1;
+}
+
+double seconds(clock_t start){
+    return (double)(clock() - start) / CLOCKS_PER_SEC;
+}
+
+void bench_single(int random){
+    int *v = make_arrivals(N_SINGLE, random);
+    int *l = (int *)malloc((BASE + N_SINGLE) * sizeof(int));
+    fill_base(l);
+    clock_t start = clock();
+    for(int i = 0; i < N_SINGLE; i++){
+        l[BASE + i] = v[i];
+        insert_last(l, BASE + i + 1);
+    }
+    double t_swap = seconds(start);
+    int ok = check(l, BASE + N_SINGLE);
+
+    struct sorted_array a;
+    sorted_init(&a);
+    for(int i = 0; i < BASE; i++){
+        sorted_insert(&a, 4 * i);
+    }
+    start = clock();
+    for(int i = 0; i < N_SINGLE; i++){
+        sorted_insert(&a, v[i]);
+    }
+    double t_insert = seconds(start);
+    ok = ok && check(a.data, a.size) && memcmp(a.data, l, a.size * sizeof(int)) == 0;
+
+    printf("single, %-6s  insertion step %8.1f ns   sorted_insert %8.1f ns%s\n",
+           random ? "random" : "nearly", t_swap / N_SINGLE * 1e9, t_insert / N_SINGLE * 1e9,
+           ok ? "" : "   WRONG");
+    sorted_free(&a);
+    free(l);
+    free(v);
+}
+
+void bench_batches(int random){
+    int total = BASE + N_BATCHES * BATCH;
+    int *v = make_arrivals(N_BATCHES * BATCH, random);
+    int *batch = (int *)malloc(BATCH * sizeof(int));
+    int *l = (int *)malloc(total * sizeof(int));
+    int *ref = (int *)malloc(total * sizeof(int));
+    const char *names[] = {"insertion_sort", "hybrid_sort", "insert_batch"};
+    double t[3];
+    int ok = 1;
+    for(int w = 0; w < 3; w++){
+        struct sorted_array a;
+        sorted_init(&a);
+        fill_base(l);
+        if(w == 2){
+            sorted_insert_batch(&a, l, BASE);
+        }
+        int size = BASE;
+        // insertion_sort on random batches would take minutes
+        int n_batches = (w == 0 && random) ? 1 : N_BATCHES;
+        clock_t start = clock();
+        for(int b = 0; b < n_batches; b++){
+            if(w == 2){
+                memcpy(batch, v + b * BATCH, BATCH * sizeof(int));
+                sorted_insert_batch(&a, batch, BATCH);
+            }
+            else{
+                memcpy(l + size, v + b * BATCH, BATCH * sizeof(int));
+                if(w == 0){
+                    insertion_sort(l, size + BATCH);
+                }
+                else{
+                    hybrid_sort(l, size + BATCH);
+                }
+            }
+            size += BATCH;
+        }
+        t[w] = seconds(start) / n_batches;
+        const int *res = w == 2 ? a.data : l;
+        if(w == 1){
+            memcpy(ref, l, total * sizeof(int));
+        }
+        ok = ok && check(res, size) && (w != 2 || memcmp(res, ref, total * sizeof(int)) == 0);
+        sorted_free(&a);
+    }
+    printf("batch,  %-6s", random ? "random" : "nearly");
+    for(int w = 0; w < 3; w++){
+        printf("  %s %8.3f ms", names[w], t[w] * 1e3);
+    }
+    printf("%s\n", ok ? "" : "   WRONG");
+    free(ref);
+    free(l);
+    free(batch);
+    free(v);
+}
+
+// kind 0: sorted with 1% of the elements moved at random,
+//      1: 16 sorted runs one after another, 2: descending, 3: random
+void bench_adaptive(int kind){
+    const char *names[] = {"1% displaced", "16 runs", "descending", "random"};
+    int *orig = (int *)malloc(BASE * sizeof(int));
+    int *l = (int *)malloc(BASE * sizeof(int));
+    int *ref = (int *)malloc(BASE * sizeof(int));
+    for(int i = 0; i < BASE; i++){
+        orig[i] = kind == 0 ? i : kind == 1 ? (i % (BASE / 16)) * 16 + i / (BASE / 16)
+                : kind == 2 ? BASE - i : rand();
+    }
+    if(kind == 0){
+        for(int k = 0; k < BASE / 100; k++){
+            int i = rand() % BASE;
+            int j = rand() % BASE;
+            int temp = orig[i];
+            orig[i] = orig[j];
+            orig[j] = temp;
+        }
+    }
+    double t[2];
+    for(int w = 0; w < 2; w++){
+        memcpy(l, orig, BASE * sizeof(int));
+        clock_t start = clock();
+        if(w == 0){
+            hybrid_sort(l, BASE);
+        }
+        else{
+            adaptive_sort(l, BASE);
+        }
+        t[w] = seconds(start);
+        if(w == 0){
+            memcpy(ref, l, BASE * sizeof(int));
+        }
+    }
+    int ok = memcmp(l, ref, BASE * sizeof(int)) == 0;
+    printf("sort,   %-12s  hybrid_sort %8.2f ms   adaptive_sort %8.2f ms%s\n",
+           names[kind], t[0] * 1e3, t[1] * 1e3, ok ? "" : "   WRONG");
+    free(ref);
+    free(l);
+    free(orig);
+}
+
+int main(){
+    srand(1);
+    for(int random = 0; random < 2; random++){
+        bench_single(random);
+    }
+    for(int random = 0; random < 2; random++){
+        bench_batches(random);
+    }
+    for(int kind = 0; kind < 4; kind++){
+        bench_adaptive(kind);
+    }
+    return 0;
+}
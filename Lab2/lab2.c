@@ -62,6 +62,34 @@ void append(struct node1* head, int type, void* value){
         cur -> next = nodea;
     }
 }
+
+// head, tail and length of a node1 list, so that appending does not have to
+// walk from head like append does
+struct list1{
+    struct node1 *head;
+    struct node1 *tail;
+    int length;
+};
+
+void list1_append(struct list1* l, int type, void* value){
+    struct node1* nodea = (struct node1*) malloc(sizeof(struct node1));
+    if (nodea == NULL){
+        printf("Error: Out of memory!\n");
+        return;
+    }
+    nodea -> p_data = value;
+    nodea -> type = type;
+    nodea -> next = NULL;
+    if (l -> tail == NULL){
+        l -> head = nodea;
+    }
+    else{
+        l -> tail -> next = nodea;
+    }
+    l -> tail = nodea;
+    l -> length++;
+}
+
 void print(struct node1* head){
     struct node1 *cur = head;
     while (cur != NULL){
@@ -114,13 +142,14 @@ int main (void){
     *(double*)(nodec -> p_data) = 3.14159;
     nodec->type = 2;
     nodec->next = NULL;
-    print(nodea);
+    struct list1 l = {nodea, nodec, 3};
+    print(l.head);
     void* new_node = malloc(sizeof(float));
     *(float*) new_node = 2.71;
-    append(nodea, 1, new_node);
-    print(nodea);
+    list1_append(&l, 1, new_node);
+    print(l.head);
     void* x = malloc(sizeof(double));
     *(double*) x = 9.816753489052480987;
-    append(nodea, 2, x);
-    print(nodea);
+    list1_append(&l, 2, x);
+    print(l.head);
 }
\ No newline at end of file
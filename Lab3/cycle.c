@@ -0,0 +1,90 @@
+#include <stdint.h>
+#include "cycle.h"
+
+static int no_cycle(size_t n_nodes, struct cycle_info *info){
+    if(info != NULL){
+        info->entry = NULL;
+        info->length = 0;
+        info->tail = n_nodes;
+    }
+    return 0;
+}
+
+// Once the length is known: a pointer that starts length nodes ahead of
+// another meets it exactly at the entry.
+static int found_cycle(struct node *head, size_t length, struct cycle_info *info){
+    if(info == NULL){
+        return 1;
+    }
+    struct node *ahead = head;
+    for(size_t i = 0; i < length; i++){
+        ahead = ahead->next;
+    }
+    struct node *behind = head;
+    size_t tail = 0;
+    while(behind != ahead){
+        behind = behind->next;
+        ahead = ahead->next;
+        tail++;
+    }
+    info->entry = behind;
+    info->length = length;
+    info->tail = tail;
+    return 1;
+}
+
+int find_cycle(struct node *head, struct cycle_info *info){
+    if(head == NULL){
+        return no_cycle(0, info);
+    }
+    struct node *tortoise = head;
+    struct node *hare = head->next;
+    size_t power = 1;
+    size_t length = 1; // steps since the tortoise last moved
+    size_t n_nodes = 1;
+    while(hare != tortoise){
+        if(hare == NULL){
+            return no_cycle(n_nodes, info);
+        }
+        if(length == power){
+            tortoise = hare;
+            power *= 2;
+            length = 0;
+        }
+        hare = hare->next;
+        length++;
+        n_nodes++;
+    }
+    // the hare went round exactly once since the tortoise last jumped
+    return found_cycle(head, length, info);
+}
+
+int find_cycle_prefetch(struct node *head, struct cycle_info *info){
+    if(head == NULL){
+        return no_cycle(0, info);
+    }
+    struct node *tortoise = head;
+    struct node *prev = head;
+    struct node *hare = head->next;
+    size_t power = 1;
+    size_t length = 1;
+    size_t n_nodes = 1;
+    while(hare != tortoise){
+        if(hare == NULL){
+            return no_cycle(n_nodes, info);
+        }
+        // only a guess, so done on integers: prefetching a bad address is harmless
+        uintptr_t stride = (uintptr_t)hare - (uintptr_t)prev;
+        __builtin_prefetch((const void *)((uintptr_t)hare + CYCLE_PREFETCH_AHEAD * stride));
+        if(length == power){
+            tortoise = hare;
+            power *= 2;
+            length = 0;
+        }
+        prev = hare;
+        hare = hare->next;
+        length++;
+        n_nodes++;
+    }
+    return found_cycle(head, length, info);
+}
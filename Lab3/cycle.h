@@ -0,0 +1,35 @@
+#if !defined(CYCLE)
+#define CYCLE
+
+#include <stddef.h>
+
+// Cycle detection for the singly linked lists of lab3.c, telling also where
+// the cycle starts and how long it is. Uses Brent's algorithm: the hare walks
+// one node at a time and the tortoise just jumps to where the hare is
+// whenever the step count reaches a power of 2. Every node is loaded once
+// (tortoise_hare loads each one up to three times, two of them cache misses
+// on a long list) and there is one NULL check per node.
+
+// the same layout as in lab3.c
+struct node{
+    void *data;
+    struct node *next;
+};
+
+struct cycle_info{
+    struct node *entry; // first node on the cycle, NULL if there is none
+    size_t length;      // nodes on the cycle, 0 if there is none
+    size_t tail;        // nodes before entry, or all nodes if no cycle
+};
+
+// 1 if the list has a cycle, like tortoise_hare; info may be NULL
+int find_cycle(struct node *head, struct cycle_info *info);
+
+// Same, but guesses the next nodes' addresses from the distance between the
+// last two, and prefetches CYCLE_PREFETCH_AHEAD of those distances ahead.
+// That can only pay for lists whose nodes were allocated one after another,
+// and only on CPUs whose own prefetcher does not follow such strides already.
+#define CYCLE_PREFETCH_AHEAD 16
+int find_cycle_prefetch(struct node *head, struct cycle_info *info);
+
+#endif
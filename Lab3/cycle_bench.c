@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "cycle.h"
+
+// Lists of N_NODES nodes, without a cycle and with the last node pointing
+// back to the middle one, their nodes linked in the order malloc returned
+// them or in random order. Times tortoise_hare from lab3.c (copied below),
+// find_cycle without and with the entry and length, and find_cycle_prefetch.
+#define N_NODES 10000000
+#define N_WAYS 4
+
+int tortoise_hare (struct node* head){
+    struct node *hare = head;
+    struct node *tortoise = head;
+    hare = hare->next;
+    if(hare == NULL){
+        return 0;
+    }
+    hare = hare->next;
+    if(hare == NULL){
+        return 0;
+    }
+    tortoise = tortoise -> next;
+
+    while (hare != tortoise){
+        hare = hare->next;
+        if(hare == NULL){
+            return 0;
+        }
+        hare = hare->next;
+        if(hare == NULL){
+            return 0;
+        }
+        tortoise = tortoise -> next;
+
+    }
+    return 1;
+}
+
+int main(){
+    const char *names[N_WAYS] = {"tortoise_hare", "find_cycle", "+entry", "+prefetch"};
+    struct node **nodes = (struct node **)malloc(N_NODES * sizeof(struct node *));
+    for(int i = 0; i < N_NODES; i++){
+        nodes[i] = (struct node *)malloc(sizeof(struct node));
+        nodes[i]->data = NULL;
+    }
+    printf("%-20s", "");
+    for(int w = 0; w < N_WAYS; w++){
+        printf(" %14s", names[w]);
+    }
+    printf("   (ms)\n");
+    srand(1);
+    for(int shuffled = 0; shuffled < 2; shuffled++){
+        if(shuffled){
+            for(int i = N_NODES - 1; i > 0; i--){
+                int j = (int)(((size_t)rand() * (RAND_MAX + 1u) + rand()) % (i + 1));
+                struct node *temp = nodes[i];
+                nodes[i] = nodes[j];
+                nodes[j] = temp;
+            }
+        }
+        for(int i = 0; i + 1 < N_NODES; i++){
+            nodes[i]->next = nodes[i+1];
+        }
+        for(int cyclic = 0; cyclic < 2; cyclic++){
+            nodes[N_NODES - 1]->next = cyclic ? nodes[N_NODES / 2] : NULL;
+            printf("%-9s %-10s", shuffled ? "shuffled" : "in order", cyclic ? "cycle" : "no cycle");
+            int ok = 1;
+            for(int w = 0; w < N_WAYS; w++){
+                struct cycle_info info;
+                clock_t start = clock();
+                int found = w == 0 ? tortoise_hare(nodes[0]) : w == 1 ? find_cycle(nodes[0], NULL)
+                          : w == 2 ? find_cycle(nodes[0], &info) : find_cycle_prefetch(nodes[0], &info);
+                double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+                printf(" %14.1f", secs * 1e3);
+                ok = ok && found == cyclic;
+                if(w >= 2){
+                    ok = ok && (cyclic ? info.entry == nodes[N_NODES / 2] && info.tail == N_NODES / 2
+                                         && info.length == N_NODES - N_NODES / 2
+                                       : info.entry == NULL && info.tail == N_NODES);
+                }
+            }
+            printf("%s\n", ok ? "" : "   WRONG");
+        }
+    }
+    for(int i = 0; i < N_NODES; i++){
+        free(nodes[i]);
+    }
+    free(nodes);
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "fast_str.h"
+#if defined(__x86_64__) || defined(__i386__)
+#define HAVE_X86 1
+#include <immintrin.h>
+#endif
+
+#define PAGE_SIZE 4096
+#define ONES  0x0101010101010101ULL
+#define HIGHS 0x8080808080808080ULL
+
+// The vector versions read whole aligned blocks, which can start before s;
+// that is safe (same page) but looks like an overflow to AddressSanitizer.
+#if defined(__GNUC__)
+#define NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define NO_ASAN
+#endif
+
+NO_ASAN size_t strlen_word(const char *s){
+    const char *cur = s;
+    while(((uintptr_t)cur & 7) != 0){
+        if(*cur == '\0'){
+            return cur - s;
+        }
+        cur++;
+    }
+    while(1){
+        uint64_t v;
+        memcpy(&v, cur, 8); // aligned, so it cannot cross a page
+        if(((v - ONES) & ~v & HIGHS) != 0){
+            break;
+        }
+        cur += 8;
+    }
+    while(*cur != '\0'){
+        cur++;
+    }
+    return cur - s;
+}
+
+int strcmp_bytes(const char *str1, const char *str2){
+    while(*str1 != '\0' && *str1 == *str2){
+        str1++;
+        str2++;
+    }
+    return *str1 - *str2;
+}
+
+#if defined(HAVE_X86)
+
+NO_ASAN size_t strlen_sse2(const char *s){
+    uintptr_t off = (uintptr_t)s & 15;
+    const __m128i *p = (const __m128i *)(s - off);
+    __m128i zero = _mm_setzero_si128();
+    unsigned int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(p), zero)) >> off;
+    if(mask != 0){
+        return __builtin_ctz(mask);
+    }
+    // one block at a time up to a 64-byte boundary, then 64 bytes per step;
+    // an aligned 64-byte group never straddles two pages
+    p++;
+    while(((uintptr_t)p & 63) != 0){
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(p), zero));
+        if(mask != 0){
+            return (const char *)p - s + __builtin_ctz(mask);
+        }
+        p++;
+    }
+    while(1){
+        __m128i m = _mm_min_epu8(_mm_min_epu8(_mm_load_si128(p), _mm_load_si128(p + 1)),
+                                 _mm_min_epu8(_mm_load_si128(p + 2), _mm_load_si128(p + 3)));
+        if(_mm_movemask_epi8(_mm_cmpeq_epi8(m, zero)) != 0){
+            break;
+        }
+        p += 4;
+    }
+    while(1){
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(p), zero));
+        if(mask != 0){
+            return (const char *)p - s + __builtin_ctz(mask);
+        }
+        p++;
+    }
+}
+
+__attribute__((target("avx2")))
+NO_ASAN size_t strlen_avx2(const char *s){
+    uintptr_t off = (uintptr_t)s & 31;
+    const __m256i *p = (const __m256i *)(s - off);
+    __m256i zero = _mm256_setzero_si256();
+    unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256(p), zero)) >> off;
+    if(mask != 0){
+        return __builtin_ctz(mask);
+    }
+    // same scheme as strlen_sse2 with 128-byte groups
+    p++;
+    while(((uintptr_t)p & 127) != 0){
+        mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256(p), zero));
+        if(mask != 0){
+            return (const char *)p - s + __builtin_ctz(mask);
+        }
+        p++;
+    }
+    while(1){
+        __m256i m = _mm256_min_epu8(_mm256_min_epu8(_mm256_load_si256(p), _mm256_load_si256(p + 1)),
+                                    _mm256_min_epu8(_mm256_load_si256(p + 2), _mm256_load_si256(p + 3)));
+        if(_mm256_movemask_epi8(_mm256_cmpeq_epi8(m, zero)) != 0){
+            break;
+        }
+        p += 4;
+    }
+    while(1){
+        mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256(p), zero));
+        if(mask != 0){
+            return (const char *)p - s + __builtin_ctz(mask);
+        }
+        p++;
+    }
+}
+
+// true if an n-byte load at p would run into the next page
+static int near_page_end(const char *p, size_t n){
+    return ((uintptr_t)p & (PAGE_SIZE - 1)) > PAGE_SIZE - n;
+}
+
+NO_ASAN int strcmp_sse2(const char *str1, const char *str2){
+    __m128i zero = _mm_setzero_si128();
+    while(1){
+        if(near_page_end(str1, 16) || near_page_end(str2, 16)){
+            if(*str1 == '\0' || *str1 != *str2){
+                return *str1 - *str2;
+            }
+            str1++;
+            str2++;
+            continue;
+        }
+        __m128i a = _mm_loadu_si128((const __m128i *)str1);
+        __m128i b = _mm_loadu_si128((const __m128i *)str2);
+        unsigned int diff = ~_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) & 0xFFFF;
+        unsigned int end = _mm_movemask_epi8(_mm_cmpeq_epi8(a, zero));
+        if((diff | end) != 0){
+            int k = __builtin_ctz(diff | end);
+            return str1[k] - str2[k];
+        }
+        str1 += 16;
+        str2 += 16;
+    }
+}
+
+__attribute__((target("avx2")))
+NO_ASAN int strcmp_avx2(const char *str1, const char *str2){
+    __m256i zero = _mm256_setzero_si256();
+    while(1){
+        if(near_page_end(str1, 32) || near_page_end(str2, 32)){
+            if(*str1 == '\0' || *str1 != *str2){
+                return *str1 - *str2;
+            }
+            str1++;
+            str2++;
+            continue;
+        }
+        __m256i a = _mm256_loadu_si256((const __m256i *)str1);
+        __m256i b = _mm256_loadu_si256((const __m256i *)str2);
+        unsigned int diff = ~(unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b));
+        unsigned int end = _mm256_movemask_epi8(_mm256_cmpeq_epi8(a, zero));
+        if((diff | end) != 0){
+            int k = __builtin_ctz(diff | end);
+            return str1[k] - str2[k];
+        }
+        str1 += 32;
+        str2 += 32;
+    }
+}
+
+#else
+
+size_t strlen_sse2(const char *s){
+    return strlen_word(s);
+}
+
+size_t strlen_avx2(const char *s){
+    return strlen_word(s);
+}
+
+int strcmp_sse2(const char *str1, const char *str2){
+    return strcmp_bytes(str1, str2);
+}
+
+int strcmp_avx2(const char *str1, const char *str2){
+    return strcmp_bytes(str1, str2);
+}
+
+#endif
+
+static size_t (*best_strlen)(const char *s) = NULL;
+static int (*best_strcmp)(const char *str1, const char *str2) = NULL;
+
+static void pick_implementations(void){
+#if defined(HAVE_X86)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")){
+        best_strcmp = strcmp_avx2;
+        best_strlen = strlen_avx2;
+        return;
+    }
+    best_strcmp = strcmp_sse2;
+    best_strlen = strlen_sse2;
+#else
+    best_strcmp = strcmp_bytes;
+    best_strlen = strlen_word;
+#endif
+}
+
+size_t fast_strlen(const char *s){
+    if(best_strlen == NULL){
+        pick_implementations();
+    }
+    return best_strlen(s);
+}
+
+int fast_strcmp(const char *str1, const char *str2){
+    if(best_strcmp == NULL){
+        pick_implementations();
+    }
+    return best_strcmp(str1, str2);
+}
+
+char *fast_strcat(const char *dest, const char *src){
+    size_t x = fast_strlen(dest);
+    size_t y = fast_strlen(src);
+    char *dest2 = (char *)malloc(x + y + 1);
+    memcpy(dest2, dest, x);
+    memcpy(dest2 + x, src, y + 1); // copies the '\0' too
+    return dest2;
+}
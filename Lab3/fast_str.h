@@ -0,0 +1,27 @@
+#if !defined(FAST_STR)
+#define FAST_STR
+
+#include <stddef.h>
+
+// Faster versions of my_strlen / my_strcmp_rec / my_strcat from lab3.c. The
+// best implementation for the CPU (AVX2, SSE2 or 8 bytes at a time) is picked
+// on the first call. Vector loads are always aligned or checked not to cross
+// into the next page, so reading past the '\0' can never fault.
+
+size_t fast_strlen(const char *s);
+
+// same result as my_strcmp_rec, without recursion
+int fast_strcmp(const char *str1, const char *str2);
+
+// new malloc'd string holding dest followed by src, like my_strcat
+char *fast_strcat(const char *dest, const char *src);
+
+// the individual implementations, for benchmarking
+size_t strlen_word(const char *s);
+size_t strlen_sse2(const char *s);
+size_t strlen_avx2(const char *s);
+int strcmp_bytes(const char *str1, const char *str2);
+int strcmp_sse2(const char *str1, const char *str2);
+int strcmp_avx2(const char *str1, const char *str2);
+
+#endif
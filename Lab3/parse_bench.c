@@ -0,0 +1,126 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <ctype.h>
+#include <math.h>
+#include <time.h>
+#include "parse_int.h"
+
+// Parses the same array of numbers with my_atoi from lab3.c (copied below),
+// strtol and parse_int, for short and long numbers. Prints millions/s.
+
+#define N_NUMS 1000000
+#define ROUNDS 5
+
+__attribute__((optimize("no-tree-loop-distribute-patterns")))
+int my_strlen(char *s1){
+    int len = 0;
+    while(*s1 != '\0'){
+        len++;
+        s1++;
+    }
+    return len;
+}
+
+int my_atoi(char *str){
+    int output = 0;
+    bool is_neg = false;
+    char *cur = str;
+    int len = my_strlen(str);
+    int pos = len-1;
+    while(*cur != '\0'){
+        if(cur == str){
+            if(*cur == '-'){
+                is_neg = true;
+                pos--;
+                cur++;
+            }
+        }
+        if(isdigit(*cur) == 0){
+            return 0;
+        }
+        else{
+            output += (*cur - '0') * pow(10, pos);
+        }
+        pos--;
+        cur++;
+    }
+    if(is_neg){
+        return (-1)*output;
+    }
+    return output;
+}
+
+static char **make_numbers(int max_digits){
+    char **nums = (char **)malloc(N_NUMS * sizeof(char *));
+    for(int i = 0; i < N_NUMS; i++){
+        int digits = 1 + rand() % max_digits;
+        char *s = (char *)malloc(digits + 2);
+        int k = 0;
+        if(rand() % 2){
+            s[k++] = '-';
+        }
+        s[k++] = '1' + rand() % 9;
+        for(int j = 1; j < digits; j++){
+            s[k++] = '0' + rand() % 10;
+        }
+        s[k] = '\0';
+        nums[i] = s;
+    }
+    return nums;
+}
+
+static void report(const char *name, clock_t start, long long check){
+    double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+    printf("  %-10s %8.1f M/s  (check %lld)\n", name, (double)N_NUMS * ROUNDS / secs / 1e6, check);
+}
+
+static void bench(int max_digits, int run_old){
+    char **nums = make_numbers(max_digits);
+    long long check;
+    clock_t start;
+    printf("up to %d digits:\n", max_digits);
+
+    if(run_old){
+        check = 0;
+        start = clock();
+        for(int r = 0; r < ROUNDS; r++){
+            for(int i = 0; i < N_NUMS; i++){
+                check += my_atoi(nums[i]);
+            }
+        }
+        report("my_atoi", start, check);
+    }
+
+    check = 0;
+    start = clock();
+    for(int r = 0; r < ROUNDS; r++){
+        for(int i = 0; i < N_NUMS; i++){
+            check += strtoll(nums[i], NULL, 10);
+        }
+    }
+    report("strtoll", start, check);
+
+    check = 0;
+    start = clock();
+    for(int r = 0; r < ROUNDS; r++){
+        for(int i = 0; i < N_NUMS; i++){
+            int64_t v;
+            parse_i64(nums[i], NULL, 10, &v);
+            check += v;
+        }
+    }
+    report("parse_i64", start, check);
+
+    for(int i = 0; i < N_NUMS; i++){
+        free(nums[i]);
+    }
+    free(nums);
+}
+
+int main(){
+    srand(1);
+    bench(9, 1); // my_atoi only works while the value fits in an int
+    bench(18, 0);
+    return 0;
+}
@@ -0,0 +1,259 @@
+#include <string.h>
+#include <limits.h>
+#include "parse_int.h"
+
+#define PAGE_SIZE 4096
+
+// eight_digits may read a few bytes past the end of the string (never past
+// its page), which AddressSanitizer would report.
+#if defined(__GNUC__)
+#define NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define NO_ASAN
+#endif
+
+// value of c as a digit (0..35), or 36 if it is not one
+static int digit_value(char c){
+    if(c >= '0' && c <= '9'){
+        return c - '0';
+    }
+    if(c >= 'a' && c <= 'z'){
+        return c - 'a' + 10;
+    }
+    if(c >= 'A' && c <= 'Z'){
+        return c - 'A' + 10;
+    }
+    return 36;
+}
+
+static int is_little_endian(void){
+    uint16_t x = 1;
+    return *(unsigned char *)&x == 1;
+}
+
+// 1 if all 8 bytes of v are '0'..'9': a byte is a digit iff it is >= '0'
+// and adding 0x46 does not carry into the top bit (i.e. it is <= '9')
+static int all_digits(uint64_t v){
+    return (((v + 0x4646464646464646ULL) | (v - 0x3030303030303030ULL)) & 0x8080808080808080ULL) == 0;
+}
+
+// value of 8 digit chars, the first one in the lowest byte (little-endian)
+static uint64_t digits_value(uint64_t v){
+    v -= 0x3030303030303030ULL;
+    v = (v * 10) + (v >> 8);
+    v = (((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)))
+        + (((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+    return v;
+}
+
+// If the 8 bytes at p are all decimal digits, stores their value in *value and
+// returns 1. Never reads across a page boundary it would not otherwise touch.
+NO_ASAN static int eight_digits(const char *p, uint64_t *value){
+    if(((uintptr_t)p & (PAGE_SIZE - 1)) > PAGE_SIZE - 8){
+        return 0;
+    }
+    uint64_t v;
+    memcpy(&v, p, 8);
+    if(!all_digits(v)){
+        return 0;
+    }
+    *value = digits_value(v);
+    return 1;
+}
+
+static int read_base_prefix(const char **p, int base){
+    const char *s = *p;
+    if(base == 0){
+        if(s[0] == '0' && (s[1] == 'x' || s[1] == 'X') && digit_value(s[2]) < 16){
+            *p += 2;
+            return 16;
+        }
+        if(s[0] == '0' && (s[1] == 'b' || s[1] == 'B') && digit_value(s[2]) < 2){
+            *p += 2;
+            return 2;
+        }
+        if(s[0] == '0' && (s[1] == 'o' || s[1] == 'O') && digit_value(s[2]) < 8){
+            *p += 2;
+            return 8;
+        }
+        return 10;
+    }
+    if(base == 16 && s[0] == '0' && (s[1] == 'x' || s[1] == 'X') && digit_value(s[2]) < 16){
+        *p += 2;
+    }
+    return base;
+}
+
+// parses the digits at *p; on overflow keeps consuming digits and returns
+// PARSE_OVERFLOW with *out = UINT64_MAX
+static int parse_digits(const char **p, int base, uint64_t *out){
+    const char *s = *p;
+    uint64_t value = 0;
+    int overflow = 0;
+    if(digit_value(*s) >= base){
+        *out = 0;
+        return PARSE_NO_DIGITS;
+    }
+
+    if(base == 10 && is_little_endian()){
+        uint64_t chunk;
+        while(eight_digits(s, &chunk)){
+            if(value > (UINT64_MAX - chunk) / 100000000ULL){
+                overflow = 1;
+            }
+            value = value * 100000000ULL + chunk;
+            s += 8;
+        }
+    }
+    while(1){
+        int d = digit_value(*s);
+        if(d >= base){
+            break;
+        }
+        if(value > (UINT64_MAX - d) / base){
+            overflow = 1;
+        }
+        value = value * base + d;
+        s++;
+    }
+
+    *p = s;
+    *out = overflow ? UINT64_MAX : value;
+    return overflow ? PARSE_OVERFLOW : PARSE_OK;
+}
+
+int parse_u64(const char *s, const char **end, int base, uint64_t *out){
+    const char *p = s;
+    if(base != 0 && (base < 2 || base > 36)){
+        *out = 0;
+        return PARSE_BAD_BASE;
+    }
+    if(*p == '+'){
+        p++;
+    }
+    base = read_base_prefix(&p, base);
+    int err = parse_digits(&p, base, out);
+    if(end != NULL){
+        *end = err == PARSE_NO_DIGITS ? s : p;
+    }
+    return err;
+}
+
+// stores the signed value of mag in *out, clamped on overflow
+static int apply_sign(uint64_t mag, int is_neg, int err, int64_t *out){
+    if(is_neg){
+        if(err == PARSE_OVERFLOW || mag > (uint64_t)INT64_MAX + 1){
+            *out = INT64_MIN;
+            return PARSE_OVERFLOW;
+        }
+        *out = mag == (uint64_t)INT64_MAX + 1 ? INT64_MIN : -(int64_t)mag;
+    }
+    else{
+        if(err == PARSE_OVERFLOW || mag > (uint64_t)INT64_MAX){
+            *out = INT64_MAX;
+            return PARSE_OVERFLOW;
+        }
+        *out = (int64_t)mag;
+    }
+    return err;
+}
+
+int parse_i64(const char *s, const char **end, int base, int64_t *out){
+    const char *p = s;
+    int is_neg = 0;
+    uint64_t mag;
+    if(base != 0 && (base < 2 || base > 36)){
+        *out = 0;
+        return PARSE_BAD_BASE;
+    }
+    if(*p == '-' || *p == '+'){
+        is_neg = *p == '-';
+        p++;
+    }
+    base = read_base_prefix(&p, base);
+    int err = parse_digits(&p, base, &mag);
+    if(end != NULL){
+        *end = err == PARSE_NO_DIGITS ? s : p;
+    }
+    if(err == PARSE_NO_DIGITS){
+        *out = 0;
+        return err;
+    }
+    return apply_sign(mag, is_neg, err, out);
+}
+
+// digits of parse_i64_n that did not fit in a single load
+static int parse_i64_n_slow(const char *p, const char *end, int is_neg, int64_t *out){
+    const char *digits = p;
+    uint64_t mag = 0;
+    int overflow = 0;
+    if(is_little_endian()){
+        uint64_t chunk;
+        while(end - p >= 8 && eight_digits(p, &chunk)){
+            if(mag > (UINT64_MAX - chunk) / 100000000ULL){
+                overflow = 1;
+            }
+            mag = mag * 100000000ULL + chunk;
+            p += 8;
+        }
+    }
+    while(p < end && *p >= '0' && *p <= '9'){
+        int d = *p - '0';
+        if(mag > (UINT64_MAX - d) / 10){
+            overflow = 1;
+        }
+        mag = mag * 10 + d;
+        p++;
+    }
+    if(p == digits){
+        *out = 0;
+        return PARSE_NO_DIGITS;
+    }
+    int err = apply_sign(mag, is_neg, overflow ? PARSE_OVERFLOW : PARSE_OK, out);
+    if(err == PARSE_OK && p != end){
+        return PARSE_TRAILING;
+    }
+    return err;
+}
+
+NO_ASAN int parse_i64_n(const char *s, size_t n, int64_t *out){
+    // no branch on the sign: in a column of numbers it is random
+    char first = n > 0 ? *s : '\0';
+    int has_sign = (first == '-') | (first == '+');
+    int is_neg = first == '-';
+    const char *p = s + has_sign;
+    size_t k = n - has_sign;
+
+    // 1 to 8 digits: one load, with the bytes after the number shifted out
+    // and '0's shifted in at the front
+    if(k - 1 < 8 && is_little_endian() && ((uintptr_t)p & (PAGE_SIZE - 1)) <= PAGE_SIZE - 8){
+        uint64_t v;
+        memcpy(&v, p, 8);
+        v <<= 8 * (8 - k);
+        v |= 0x3030303030303030ULL & ~(~0ULL << (8 * (8 - k)));
+        if(all_digits(v)){
+            int64_t mag = (int64_t)digits_value(v);
+            *out = is_neg ? -mag : mag;
+            return PARSE_OK;
+        }
+    }
+    return parse_i64_n_slow(p, s + n, is_neg, out);
+}
+
+int parse_int(const char *s, int *out){
+    const char *end;
+    int64_t v;
+    int err = parse_i64(s, &end, 10, &v);
+    if(err == PARSE_OK && (v < INT_MIN || v > INT_MAX)){
+        err = PARSE_OVERFLOW;
+    }
+    if(err == PARSE_OVERFLOW){
+        *out = v < 0 ? INT_MIN : INT_MAX;
+        return err;
+    }
+    *out = (int)v;
+    if(err == PARSE_OK && *end != '\0'){
+        return PARSE_TRAILING;
+    }
+    return err;
+}
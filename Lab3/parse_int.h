@@ -0,0 +1,31 @@
+#if !defined(PARSE_INT)
+#define PARSE_INT
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Replacement for my_atoi that reports where it stopped and what went wrong.
+// Parsing stops at the first character that is not a digit of the base and
+// *end (if end != NULL) is set to it, like strtol. Decimal digits are
+// converted 8 at a time.
+//
+// base is 2..36, or 0 to read the base from a prefix: "0x" hex, "0b" binary,
+// "0o" octal, anything else decimal (so "0021" is 21, like my_atoi).
+
+#define PARSE_OK 0
+#define PARSE_NO_DIGITS 1 // no digits where the number should start
+#define PARSE_OVERFLOW 2  // the value does not fit; *out is clamped
+#define PARSE_TRAILING 3  // parse_int(_n): characters after the number
+#define PARSE_BAD_BASE 4
+
+int parse_u64(const char *s, const char **end, int base, uint64_t *out);
+int parse_i64(const char *s, const char **end, int base, int64_t *out);
+
+// decimal only, parses exactly the n chars at s (which need no '\0'); used by
+// tokenize.c to convert fields in place
+int parse_i64_n(const char *s, size_t n, int64_t *out);
+
+// whole-string int, the checked version of my_atoi
+int parse_int(const char *s, int *out);
+
+#endif
@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "fast_str.h"
+
+// Compares the lab3.c versions (copied below), the fast_str.c versions and
+// libc on strings from 1 byte to 1 MB. Prints MB/s.
+
+#define TOTAL_BYTES (64 << 20) // work per measurement
+#define OLD_STRCMP_MAX (1 << 16) // my_strcmp_rec recurses once per char
+
+// without this GCC turns the loop into a call to libc strlen at -O2
+__attribute__((optimize("no-tree-loop-distribute-patterns")))
+int my_strlen(char *s1){
+    int len = 0;
+    while(*s1 != '\0'){
+        len++;
+        s1++;
+    }
+    return len;
+}
+
+int my_strcmp_rec(char *str1, char *str2){
+    if(*str1 == '\0' && *str2 == '\0'){
+        return 0;
+    }
+    else if(*str1 == '\0'){
+        return 0 - *str2;
+    }
+    else if(*str2 == '\0'){
+        return *str1 - 0;
+    }
+    else if(*str1 != *str2){
+        return *str1 - *str2;
+    }
+    return my_strcmp_rec(str1 + 1, str2 + 1);
+}
+
+static size_t lab3_strlen(const char *s){
+    return my_strlen((char *)s);
+}
+
+static size_t libc_strlen(const char *s){
+    return strlen(s);
+}
+
+static int lab3_strcmp(const char *a, const char *b){
+    return my_strcmp_rec((char *)a, (char *)b);
+}
+
+static int libc_strcmp(const char *a, const char *b){
+    return strcmp(a, b);
+}
+
+volatile size_t sink;
+
+static double time_strlen(size_t (*f)(const char *), const char *s, size_t len){
+    size_t reps = TOTAL_BYTES / (len + 1) + 1;
+    clock_t start = clock();
+    for(size_t r = 0; r < reps; r++){
+        sink += f(s);
+    }
+    double t = (double)(clock() - start) / CLOCKS_PER_SEC;
+    return t > 0 ? reps * (double)len / t / 1e6 : 0;
+}
+
+static double time_strcmp(int (*f)(const char *, const char *), const char *a, const char *b, size_t len){
+    size_t reps = TOTAL_BYTES / (len + 1) + 1;
+    clock_t start = clock();
+    for(size_t r = 0; r < reps; r++){
+        sink += f(a, b);
+    }
+    double t = (double)(clock() - start) / CLOCKS_PER_SEC;
+    return t > 0 ? reps * (double)len / t / 1e6 : 0;
+}
+
+int main(void){
+    size_t max_len = 1 << 20;
+    char *a = (char *)malloc(max_len + 64);
+    char *b = (char *)malloc(max_len + 64);
+
+    printf("%8s | strlen: %8s %8s %8s %8s %8s | strcmp: %8s %8s %8s %8s %8s\n", "bytes",
+           "lab3", "word", "sse2", "avx2", "libc", "lab3", "bytes", "sse2", "avx2", "libc");
+    for(size_t len = 1; len <= max_len; len *= 4){
+        // start one byte past alignment so the unaligned head is exercised
+        char *s1 = a + 1;
+        char *s2 = b + 3;
+        memset(s1, 'x', len);
+        memset(s2, 'x', len);
+        s1[len] = '\0';
+        s2[len] = '\0';
+        if(fast_strlen(s1) != len || fast_strcmp(s1, s2) != 0){
+            printf("Error: wrong result at length %lu!\n", (unsigned long)len);
+        }
+
+        printf("%8lu | strlen: %8.0f %8.0f %8.0f %8.0f %8.0f | strcmp: ", (unsigned long)len,
+               time_strlen(lab3_strlen, s1, len), time_strlen(strlen_word, s1, len),
+               time_strlen(strlen_sse2, s1, len), time_strlen(strlen_avx2, s1, len),
+               time_strlen(libc_strlen, s1, len));
+        if(len <= OLD_STRCMP_MAX){
+            printf("%8.0f ", time_strcmp(lab3_strcmp, s1, s2, len));
+        }
+        else{
+            printf("%8s ", "-");
+        }
+        printf("%8.0f %8.0f %8.0f %8.0f\n", time_strcmp(strcmp_bytes, s1, s2, len),
+               time_strcmp(strcmp_sse2, s1, s2, len), time_strcmp(strcmp_avx2, s1, s2, len),
+               time_strcmp(libc_strcmp, s1, s2, len));
+    }
+    free(a);
+    free(b);
+    return 0;
+}
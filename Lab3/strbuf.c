@@ -0,0 +1,90 @@
+#include <stdlib.h>
+#include <string.h>
+#include "strbuf.h"
+#include "fast_str.h"
+
+static char *chars(struct strbuf *sb){
+    return sb->capacity == 0 ? sb->data.small : sb->data.heap;
+}
+
+void strbuf_init(struct strbuf *sb){
+    sb->length = 0;
+    sb->capacity = 0;
+    sb->data.small[0] = '\0';
+}
+
+void strbuf_from_cstr(struct strbuf *sb, const char *s){
+    strbuf_init(sb);
+    strbuf_append(sb, s);
+}
+
+// makes room for a string of the given length (plus its '\0')
+void strbuf_reserve(struct strbuf *sb, size_t length){
+    size_t cap = sb->capacity == 0 ? STRBUF_SMALL : sb->capacity;
+    if(length <= cap){
+        return;
+    }
+    while(cap < length){
+        cap *= 2;
+    }
+    if(sb->capacity == 0){
+        char *heap = (char *)malloc(cap + 1);
+        memcpy(heap, sb->data.small, sb->length + 1);
+        sb->data.heap = heap;
+    }
+    else{
+        sb->data.heap = (char *)realloc(sb->data.heap, cap + 1);
+    }
+    sb->capacity = cap;
+}
+
+void strbuf_append_n(struct strbuf *sb, const char *s, size_t n){
+    // s may point into sb itself, which can move when it grows
+    char *old = chars(sb);
+    int inside = s >= old && s <= old + sb->length;
+    size_t offset = s - old;
+    strbuf_reserve(sb, sb->length + n);
+    if(inside){
+        s = chars(sb) + offset;
+    }
+    char *dest = chars(sb);
+    memmove(dest + sb->length, s, n);
+    sb->length += n;
+    dest[sb->length] = '\0';
+}
+
+void strbuf_append(struct strbuf *sb, const char *s){
+    strbuf_append_n(sb, s, fast_strlen(s));
+}
+
+void strbuf_append_char(struct strbuf *sb, char c){
+    strbuf_append_n(sb, &c, 1);
+}
+
+void strbuf_append_buf(struct strbuf *sb, struct strbuf *other){
+    strbuf_append_n(sb, chars(other), other->length);
+}
+
+const char *strbuf_cstr(struct strbuf *sb){
+    return chars(sb);
+}
+
+char *strbuf_release(struct strbuf *sb){
+    char *s;
+    if(sb->capacity == 0){
+        s = (char *)malloc(sb->length + 1);
+        memcpy(s, sb->data.small, sb->length + 1);
+    }
+    else{
+        s = sb->data.heap;
+    }
+    strbuf_init(sb);
+    return s;
+}
+
+void strbuf_free(struct strbuf *sb){
+    if(sb->capacity != 0){
+        free(sb->data.heap);
+    }
+    strbuf_init(sb);
+}
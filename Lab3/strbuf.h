@@ -0,0 +1,35 @@
+#if !defined(STRBUF)
+#define STRBUF
+
+#include <stddef.h>
+
+// A growable string that knows its length, so appending never re-measures
+// what is already there. The heap buffer doubles when it fills up, which makes
+// n appends O(total length) instead of the O(n^2) of repeated my_strcat.
+// Strings of up to STRBUF_SMALL chars are kept inside the struct itself.
+#define STRBUF_SMALL 23
+
+struct strbuf{
+    size_t length;
+    size_t capacity; // 0 while the string lives in small
+    union{
+        char *heap;
+        char small[STRBUF_SMALL + 1];
+    } data;
+};
+
+void strbuf_init(struct strbuf *sb);
+void strbuf_from_cstr(struct strbuf *sb, const char *s);
+void strbuf_reserve(struct strbuf *sb, size_t length);
+void strbuf_append_n(struct strbuf *sb, const char *s, size_t n);
+void strbuf_append(struct strbuf *sb, const char *s);
+void strbuf_append_char(struct strbuf *sb, char c);
+void strbuf_append_buf(struct strbuf *sb, struct strbuf *other);
+const char *strbuf_cstr(struct strbuf *sb);
+
+// hands the contents over as a malloc'd C string and empties sb
+char *strbuf_release(struct strbuf *sb);
+
+void strbuf_free(struct strbuf *sb);
+
+#endif
@@ -0,0 +1,423 @@
+#define _DEFAULT_SOURCE // madvise
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "tokenize.h"
+#include "parse_int.h"
+#if defined(__x86_64__) || defined(__i386__)
+#define HAVE_X86 1
+#include <immintrin.h>
+#endif
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define MAX_THREADS 64
+#define MASK_BATCH 64 // 64-byte blocks classified per call of find_delims
+#define MAX_FLOAT_CHARS 128
+
+static int is_delim(char c){
+    return c == ',' || c == ';' || c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+#if !defined(HAVE_X86)
+
+// Sets bit i of masks[b] if byte 64*b + i of p is a delimiter.
+static void find_delims_bytes(const char *p, size_t n_blocks, uint64_t *masks){
+    for(size_t b = 0; b < n_blocks; b++){
+        uint64_t mask = 0;
+        for(int i = 0; i < 64; i++){
+            mask |= (uint64_t)is_delim(p[64*b + i]) << i;
+        }
+        masks[b] = mask;
+    }
+}
+
+#else
+
+static unsigned int delims_16(__m128i v){
+    __m128i d = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(',')),
+                                          _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))),
+                             _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(' ')),
+                                          _mm_cmpeq_epi8(v, _mm_set1_epi8(';'))));
+    d = _mm_or_si128(d, _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\r')),
+                                     _mm_cmpeq_epi8(v, _mm_set1_epi8('\t'))));
+    return (unsigned int)_mm_movemask_epi8(d);
+}
+
+// same as find_delims_bytes: bit i of masks[b] is byte 64*b + i of p
+static void find_delims_sse2(const char *p, size_t n_blocks, uint64_t *masks){
+    for(size_t b = 0; b < n_blocks; b++, p += 64){
+        uint64_t m0 = delims_16(_mm_loadu_si128((const __m128i *)p));
+        uint64_t m1 = delims_16(_mm_loadu_si128((const __m128i *)(p + 16)));
+        uint64_t m2 = delims_16(_mm_loadu_si128((const __m128i *)(p + 32)));
+        uint64_t m3 = delims_16(_mm_loadu_si128((const __m128i *)(p + 48)));
+        masks[b] = m0 | (m1 << 16) | (m2 << 32) | (m3 << 48);
+    }
+}
+
+__attribute__((target("avx2")))
+static inline uint32_t delims_32(__m256i v){
+    __m256i d = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(',')),
+                                                _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n'))),
+                                _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8(' ')),
+                                                _mm256_cmpeq_epi8(v, _mm256_set1_epi8(';'))));
+    d = _mm256_or_si256(d, _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')),
+                                           _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t'))));
+    return (uint32_t)_mm256_movemask_epi8(d);
+}
+
+__attribute__((target("avx2")))
+static void find_delims_avx2(const char *p, size_t n_blocks, uint64_t *masks){
+    for(size_t b = 0; b < n_blocks; b++, p += 64){
+        uint64_t lo = delims_32(_mm256_loadu_si256((const __m256i *)p));
+        uint64_t hi = delims_32(_mm256_loadu_si256((const __m256i *)(p + 32)));
+        masks[b] = lo | (hi << 32);
+    }
+}
+
+#endif
+
+static void (*find_delims)(const char *p, size_t n_blocks, uint64_t *masks) = NULL;
+
+static void pick_implementation(void){
+#if defined(HAVE_X86)
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")){
+        find_delims = find_delims_avx2;
+        return;
+    }
+    find_delims = find_delims_sse2;
+#else
+    find_delims = find_delims_bytes;
+#endif
+}
+
+static const double pow10_table[23] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+// Parses [-+]digits[.digits][(e|E)[-+]digits] from exactly the n chars at s.
+// When the digits fit in 53 bits and the power of ten is at most 22, one
+// multiply or divide of two exact doubles gives the correctly rounded result;
+// anything else is handed to strtod.
+static int parse_double_n(const char *s, size_t n, double *out){
+    const char *p = s;
+    const char *end = s + n;
+    int is_neg = 0;
+    uint64_t mant = 0;
+    int n_digits = 0;
+    int truncated = 0;
+    int any_digits = 0;
+    long exp10 = 0;
+    if(p < end && (*p == '-' || *p == '+')){
+        is_neg = *p == '-';
+        p++;
+    }
+    for(; p < end && *p >= '0' && *p <= '9'; p++){
+        any_digits = 1;
+        if(n_digits < 19){
+            if(mant != 0 || *p != '0'){
+                mant = mant * 10 + (*p - '0');
+                n_digits++;
+            }
+        }
+        else{
+            truncated |= *p != '0';
+            exp10++;
+        }
+    }
+    if(p < end && *p == '.'){
+        p++;
+        for(; p < end && *p >= '0' && *p <= '9'; p++){
+            any_digits = 1;
+            if(n_digits < 19){
+                if(mant != 0 || *p != '0'){
+                    mant = mant * 10 + (*p - '0');
+                    n_digits++;
+                }
+                exp10--;
+            }
+            else{
+                truncated |= *p != '0';
+            }
+        }
+    }
+    if(!any_digits){
+        return 0;
+    }
+    if(p < end && (*p == 'e' || *p == 'E')){
+        int exp_neg = 0;
+        long e = 0;
+        p++;
+        if(p < end && (*p == '-' || *p == '+')){
+            exp_neg = *p == '-';
+            p++;
+        }
+        if(p == end || *p < '0' || *p > '9'){
+            return 0;
+        }
+        for(; p < end && *p >= '0' && *p <= '9'; p++){
+            if(e < 100000){
+                e = e * 10 + (*p - '0');
+            }
+        }
+        exp10 += exp_neg ? -e : e;
+    }
+    if(p != end){
+        return 0;
+    }
+
+    double v;
+    if(!truncated && mant <= (1ULL << 53) && exp10 >= -22 && exp10 <= 22){
+        v = (double)mant;
+        v = exp10 < 0 ? v / pow10_table[-exp10] : v * pow10_table[exp10];
+        *out = is_neg ? -v : v;
+        return 1;
+    }
+    char small[MAX_FLOAT_CHARS];
+    char *copy = n < MAX_FLOAT_CHARS ? small : (char *)malloc(n + 1);
+    memcpy(copy, s, n);
+    copy[n] = '\0';
+    *out = strtod(copy, NULL);
+    if(copy != small){
+        free(copy);
+    }
+    return 1;
+}
+
+static int parse_field(const char *p, size_t n, void *out, size_t i, int is_float){
+    if(is_float){
+        return parse_double_n(p, n, (double *)out + i);
+    }
+    return parse_i64_n(p, n, (int64_t *)out + i) == PARSE_OK;
+}
+
+size_t tokenize_max_fields(size_t len){
+    // every field but the last is followed by a delimiter
+    return len / 2 + 1;
+}
+
+static size_t tokenize(const char *buf, size_t len, void *out, int is_float, size_t *n_bad){
+    size_t count = 0;
+    size_t bad = 0;
+    size_t field_start = 0;
+    size_t pos = 0;
+    uint64_t masks[MASK_BATCH];
+    if(find_delims == NULL){
+        pick_implementation();
+    }
+
+    while(len - pos >= 64){
+        size_t n_blocks = (len - pos) / 64;
+        if(n_blocks > MASK_BATCH){
+            n_blocks = MASK_BATCH;
+        }
+        find_delims(buf + pos, n_blocks, masks);
+        for(size_t b = 0; b < n_blocks; b++){
+            uint64_t mask = masks[b];
+            while(mask != 0){
+                size_t d = pos + 64*b + __builtin_ctzll(mask);
+                mask &= mask - 1;
+                if(d > field_start){
+                    if(parse_field(buf + field_start, d - field_start, out, count, is_float)){
+                        count++;
+                    }
+                    else{
+                        bad++;
+                    }
+                }
+                field_start = d + 1;
+            }
+        }
+        pos += 64 * n_blocks;
+    }
+    for(; pos <= len; pos++){
+        if(pos == len || is_delim(buf[pos])){
+            if(pos > field_start){
+                if(parse_field(buf + field_start, pos - field_start, out, count, is_float)){
+                    count++;
+                }
+                else{
+                    bad++;
+                }
+            }
+            field_start = pos + 1;
+        }
+    }
+
+    if(n_bad != NULL){
+        *n_bad = bad;
+    }
+    return count;
+}
+
+size_t tokenize_ints(const char *buf, size_t len, int64_t *out, size_t *n_bad){
+    return tokenize(buf, len, out, 0, n_bad);
+}
+
+size_t tokenize_doubles(const char *buf, size_t len, double *out, size_t *n_bad){
+    return tokenize(buf, len, out, 1, n_bad);
+}
+
+static const char *map_file(const char *filename, size_t *len){
+#if defined(_WIN32)
+    FILE *fp = fopen(filename, "rb");
+    if(fp == NULL){
+        return NULL;
+    }
+    fseek(fp, 0, SEEK_END);
+    *len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    char *data = (char *)malloc(*len + 1);
+    if(data != NULL && fread(data, 1, *len, fp) != *len){
+        free(data);
+        data = NULL;
+    }
+    fclose(fp);
+    return data;
+#else
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0){
+        return NULL;
+    }
+    struct stat st;
+    if(fstat(fd, &st) != 0){
+        close(fd);
+        return NULL;
+    }
+    *len = st.st_size;
+    if(*len == 0){
+        close(fd);
+        return "";
+    }
+    void *data = mmap(NULL, *len, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if(data == MAP_FAILED){
+        return NULL;
+    }
+    madvise(data, *len, MADV_SEQUENTIAL);
+    return (const char *)data;
+#endif
+}
+
+static void unmap_file(const char *data, size_t len){
+#if defined(_WIN32)
+    free((char *)data);
+#else
+    if(len > 0){
+        munmap((void *)data, len);
+    }
+#endif
+}
+
+struct tokenize_job{
+    const char *buf;
+    size_t len;
+    void *out; // this job's part of the shared output
+    int is_float;
+    size_t count;
+    size_t n_bad;
+};
+
+static void *tokenize_job(void *arg){
+    struct tokenize_job *job = (struct tokenize_job *)arg;
+    job->count = tokenize(job->buf, job->len, job->out, job->is_float, &job->n_bad);
+    return NULL;
+}
+
+static void *tokenize_file(const char *filename, size_t *count, size_t *n_bad, int n_threads, int is_float){
+    size_t len;
+    const char *buf = map_file(filename, &len);
+    if(buf == NULL){
+        printf("Error: Could not read %s!\n", filename);
+        return NULL;
+    }
+    if(n_threads > MAX_THREADS){
+        n_threads = MAX_THREADS;
+    }
+    if(n_threads < 1){
+        n_threads = 1;
+    }
+    if(find_delims == NULL){
+        pick_implementation();
+    }
+
+    // piece t starts at the first delimiter at or after len*t/n_threads, so
+    // no field is cut in two; each piece gets its own stretch of the output
+    struct tokenize_job jobs[MAX_THREADS];
+    size_t elem_size = is_float ? sizeof(double) : sizeof(int64_t);
+    size_t starts[MAX_THREADS + 1];
+    size_t total_room = 0;
+    starts[0] = 0;
+    starts[n_threads] = len;
+    for(int t = 1; t < n_threads; t++){
+        size_t s = len * t / n_threads;
+        if(s < starts[t-1]){
+            s = starts[t-1];
+        }
+        while(s < len && !is_delim(buf[s])){
+            s++;
+        }
+        starts[t] = s;
+    }
+    for(int t = 0; t < n_threads; t++){
+        total_room += tokenize_max_fields(starts[t+1] - starts[t]);
+    }
+    char *out = (char *)malloc(total_room * elem_size);
+    if(out == NULL){
+        printf("Error: Out of memory!\n");
+        unmap_file(buf, len);
+        return NULL;
+    }
+    size_t room = 0;
+    for(int t = 0; t < n_threads; t++){
+        jobs[t].buf = buf + starts[t];
+        jobs[t].len = starts[t+1] - starts[t];
+        jobs[t].out = out + room * elem_size;
+        jobs[t].is_float = is_float;
+        room += tokenize_max_fields(jobs[t].len);
+    }
+
+    pthread_t threads[MAX_THREADS];
+    if(n_threads > 1){
+        for(int t = 0; t < n_threads; t++){
+            pthread_create(&threads[t], NULL, tokenize_job, &jobs[t]);
+        }
+        for(int t = 0; t < n_threads; t++){
+            pthread_join(threads[t], NULL);
+        }
+    }
+    else{
+        tokenize_job(&jobs[0]);
+    }
+    unmap_file(buf, len);
+
+    // close the gaps between the pieces
+    size_t n = 0;
+    size_t bad = 0;
+    for(int t = 0; t < n_threads; t++){
+        memmove(out + n * elem_size, jobs[t].out, jobs[t].count * elem_size);
+        n += jobs[t].count;
+        bad += jobs[t].n_bad;
+    }
+    char *shrunk = (char *)realloc(out, (n > 0 ? n : 1) * elem_size);
+    *count = n;
+    if(n_bad != NULL){
+        *n_bad = bad;
+    }
+    return shrunk != NULL ? shrunk : out;
+}
+
+int64_t *tokenize_file_ints(const char *filename, size_t *count, size_t *n_bad, int n_threads){
+    return (int64_t *)tokenize_file(filename, count, n_bad, n_threads, 0);
+}
+
+double *tokenize_file_doubles(const char *filename, size_t *count, size_t *n_bad, int n_threads){
+    return (double *)tokenize_file(filename, count, n_bad, n_threads, 1);
+}
@@ -0,0 +1,26 @@
+#if !defined(TOKENIZE)
+#define TOKENIZE
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Turns a buffer of delimited numbers ("3,1,4\n1,5,9\n") into an array in
+// one pass. Any of , ; space tab \r \n separates fields; empty fields are
+// skipped. Delimiters are found 64 bytes at a time with AVX2 or SSE2 (picked
+// on the first call) and each field is parsed where it lies, with no copy and
+// no '\0' needed. Fields that are not a valid number are skipped and counted
+// in *n_bad.
+
+// room out must have for a buffer of len bytes
+size_t tokenize_max_fields(size_t len);
+
+// return the number of values stored in out
+size_t tokenize_ints(const char *buf, size_t len, int64_t *out, size_t *n_bad);
+size_t tokenize_doubles(const char *buf, size_t len, double *out, size_t *n_bad);
+
+// Maps the file and tokenizes it in n_threads pieces (split on delimiters).
+// Return a malloc'd array of *count values, or NULL if the file can't be read.
+int64_t *tokenize_file_ints(const char *filename, size_t *count, size_t *n_bad, int n_threads);
+double *tokenize_file_doubles(const char *filename, size_t *count, size_t *n_bad, int n_threads);
+
+#endif
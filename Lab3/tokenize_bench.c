@@ -0,0 +1,127 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "tokenize.h"
+
+// Tokenizes ~100 MB of integer CSV (and a float CSV) held in memory, compared
+// with a strtoll / strtod loop, then reads the same data back from a file
+// with 1..4 threads. The first 1 MB is also tokenized 100 times over, which
+// keeps it in cache and shows the parsing speed apart from memory bandwidth
+// (best round, as the other measurements are easily disturbed). Prints MB/s.
+
+#define TARGET_BYTES (100 << 20)
+#define CACHED_BYTES (1 << 20)
+#define CACHED_ROUNDS 100
+#define FILE_NAME "tokenize_bench.csv"
+
+static char *make_csv(size_t *len, int floats){
+    char *buf = (char *)malloc(TARGET_BYTES + 64);
+    size_t n = 0;
+    int col = 0;
+    while(n < TARGET_BYTES){
+        if(floats){
+            n += sprintf(buf + n, "%d.%03d", rand() % 100000 - 50000, rand() % 1000);
+        }
+        else{
+            n += sprintf(buf + n, "%d", rand() % 2000001 - 1000000);
+        }
+        col++;
+        if(col == 10){
+            buf[n++] = '\n';
+            col = 0;
+        }
+        else{
+            buf[n++] = ',';
+        }
+    }
+    buf[n] = '\0';
+    *len = n;
+    return buf;
+}
+
+static double mb_per_s(size_t len, clock_t start){
+    double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+    return len / secs / (1 << 20);
+}
+
+int main(){
+    size_t len;
+    size_t n_bad;
+    clock_t start;
+    srand(1);
+
+    char *csv = make_csv(&len, 0);
+    int64_t *ints = (int64_t *)malloc(tokenize_max_fields(len) * sizeof(int64_t));
+    printf("int CSV, %.0f MB:\n", len / (double)(1 << 20));
+
+    start = clock();
+    size_t n_ref = 0;
+    char *p = csv;
+    while(*p != '\0'){
+        char *end;
+        ints[n_ref++] = strtoll(p, &end, 10);
+        p = end + 1;
+    }
+    printf("  strtoll loop    %7.0f MB/s  (%zu values)\n", mb_per_s(len, start), n_ref);
+
+    start = clock();
+    size_t n = tokenize_ints(csv, len, ints, &n_bad);
+    printf("  tokenize_ints   %7.0f MB/s  (%zu values, %zu bad)\n", mb_per_s(len, start), n, n_bad);
+
+    // end the cached piece on a delimiter
+    size_t cached = CACHED_BYTES;
+    while(csv[cached - 1] != ',' && csv[cached - 1] != '\n'){
+        cached--;
+    }
+    double best = 0;
+    for(int r = 0; r < CACHED_ROUNDS; r++){
+        start = clock();
+        tokenize_ints(csv, cached, ints, &n_bad);
+        double speed = mb_per_s(cached, start);
+        if(speed > best){
+            best = speed;
+        }
+    }
+    printf("  in cache        %7.0f MB/s\n", best);
+
+    FILE *fp = fopen(FILE_NAME, "wb");
+    fwrite(csv, 1, len, fp);
+    fclose(fp);
+    for(int t = 1; t <= 4; t *= 2){
+        // clock() adds up the time of all threads, so measure wall time here
+        struct timespec t0, t1;
+        size_t count;
+        clock_gettime(CLOCK_MONOTONIC, &t0);
+        int64_t *from_file = tokenize_file_ints(FILE_NAME, &count, &n_bad, t);
+        clock_gettime(CLOCK_MONOTONIC, &t1);
+        double secs = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9;
+        printf("  file, %d thread%s %7.0f MB/s  (%s)\n", t, t == 1 ? " " : "s", len / secs / (1 << 20),
+               count == n && memcmp(from_file, ints, n * sizeof(int64_t)) == 0 ? "same" : "DIFFERENT");
+        free(from_file);
+    }
+    remove(FILE_NAME);
+    free(ints);
+    free(csv);
+
+    csv = make_csv(&len, 1);
+    double *doubles = (double *)malloc(tokenize_max_fields(len) * sizeof(double));
+    printf("float CSV, %.0f MB:\n", len / (double)(1 << 20));
+
+    start = clock();
+    n_ref = 0;
+    p = csv;
+    while(*p != '\0'){
+        char *end;
+        doubles[n_ref++] = strtod(p, &end);
+        p = end + 1;
+    }
+    printf("  strtod loop     %7.0f MB/s  (%zu values)\n", mb_per_s(len, start), n_ref);
+
+    start = clock();
+    n = tokenize_doubles(csv, len, doubles, &n_bad);
+    printf("  tokenize_doubles %6.0f MB/s  (%zu values, %zu bad)\n", mb_per_s(len, start), n, n_bad);
+    free(doubles);
+    free(csv);
+    return 0;
+}
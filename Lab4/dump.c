@@ -0,0 +1,225 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <math.h>
+#include <unistd.h>
+#include "dump.h"
+
+#define MAX_NUMBER_LEN 512 // enough for printf("%.9f") of any double
+
+static const char DIGIT_PAIRS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+
+void dump_open(struct dump_writer *w, int fd, int binary){
+    w->fd = fd;
+    w->binary = binary;
+    w->len = 0;
+    w->buf = (char *)malloc(DUMP_BUF_SIZE);
+}
+
+static void write_all(int fd, const char *data, size_t len){
+    size_t done = 0;
+    while(done < len){
+        ssize_t n = write(fd, data + done, len - done);
+        if(n <= 0){
+            printf("Error: Could not write dump!\n");
+            return;
+        }
+        done += n;
+    }
+}
+
+void dump_flush(struct dump_writer *w){
+    write_all(w->fd, w->buf, w->len);
+    w->len = 0;
+}
+
+void dump_close(struct dump_writer *w){
+    dump_flush(w);
+    free(w->buf);
+    w->buf = NULL;
+}
+
+// makes sure n more bytes fit in the buffer
+static void reserve(struct dump_writer *w, size_t n){
+    if(w->len + n > DUMP_BUF_SIZE){
+        dump_flush(w);
+    }
+}
+
+void dump_bytes(struct dump_writer *w, const void *data, size_t n){
+    if(n > DUMP_BUF_SIZE){
+        dump_flush(w);
+        write_all(w->fd, (const char *)data, n);
+        return;
+    }
+    reserve(w, n);
+    memcpy(w->buf + w->len, data, n);
+    w->len += n;
+}
+
+void dump_char(struct dump_writer *w, char c){
+    reserve(w, 1);
+    w->buf[w->len++] = c;
+}
+
+// writes the decimal digits of v, padded with zeros to at least min_digits
+static void put_u64(struct dump_writer *w, uint64_t v, int min_digits){
+    char tmp[24];
+    int pos = sizeof(tmp);
+    while(v >= 100){
+        int pair = (v % 100) * 2;
+        v /= 100;
+        tmp[--pos] = DIGIT_PAIRS[pair + 1];
+        tmp[--pos] = DIGIT_PAIRS[pair];
+    }
+    if(v >= 10){
+        tmp[--pos] = DIGIT_PAIRS[v * 2 + 1];
+        tmp[--pos] = DIGIT_PAIRS[v * 2];
+    }
+    else{
+        tmp[--pos] = '0' + v;
+    }
+    while((int)sizeof(tmp) - pos < min_digits){
+        tmp[--pos] = '0';
+    }
+    memcpy(w->buf + w->len, tmp + pos, sizeof(tmp) - pos);
+    w->len += sizeof(tmp) - pos;
+}
+
+void dump_int(struct dump_writer *w, int x){
+    if(w->binary){
+        dump_bytes(w, &x, sizeof(x));
+        return;
+    }
+    reserve(w, 12);
+    uint64_t v = x;
+    if(x < 0){
+        w->buf[w->len++] = '-';
+        v = -(int64_t)x;
+    }
+    put_u64(w, v, 1);
+}
+
+void dump_fixed(struct dump_writer *w, double x, int decimals){
+    if(w->binary){
+        dump_bytes(w, &x, sizeof(x));
+        return;
+    }
+    reserve(w, MAX_NUMBER_LEN);
+    if(decimals >= 0 && decimals <= 9 && isfinite(x)){
+        // x * 10^decimals is exact for floats; for doubles it is only trusted
+        // when it is not close to a rounding tie
+        double s = fabs(x) * POW10[decimals];
+        double frac = s - floor(s);
+        if(s < 9007199254740992.0 && fabs(frac - 0.5) > s * 1e-15){
+            uint64_t r = (uint64_t)nearbyint(s);
+            uint64_t scale = (uint64_t)POW10[decimals];
+            if(signbit(x)){
+                w->buf[w->len++] = '-';
+            }
+            put_u64(w, r / scale, 1);
+            if(decimals > 0){
+                w->buf[w->len++] = '.';
+                put_u64(w, r % scale, decimals);
+            }
+            return;
+        }
+    }
+    int n = snprintf(w->buf + w->len, MAX_NUMBER_LEN, "%.*f", decimals, x);
+    w->len += n < MAX_NUMBER_LEN ? n : MAX_NUMBER_LEN - 1;
+}
+
+void dump_general(struct dump_writer *w, double x){
+    if(w->binary){
+        dump_bytes(w, &x, sizeof(x));
+        return;
+    }
+    reserve(w, MAX_NUMBER_LEN);
+    double a = fabs(x);
+    // %g prints 6 significant digits, in fixed notation when the exponent X
+    // after rounding is -4 .. 5, with 5 - X decimals and trailing zeros cut
+    if(isfinite(x) && a >= 1e-4 && a < 1e6){
+        int e = (int)floor(log10(a));
+        for(int tries = 0; tries < 3 && e >= -4 && e <= 5; tries++){
+            int decimals = 5 - e;
+            double s = a * POW10[decimals];
+            double frac = s - floor(s);
+            if(fabs(frac - 0.5) <= s * 1e-15){
+                break; // (close to) a tie, leave the rounding to snprintf
+            }
+            uint64_t r = (uint64_t)nearbyint(s);
+            if(r < 100000){
+                e--; // log10 was off by one
+            }
+            else if(r >= 1000000){
+                e++; // log10 was off by one, or rounding carried into a new digit
+            }
+            else{
+                uint64_t scale = (uint64_t)POW10[decimals];
+                uint64_t int_part = r / scale;
+                uint64_t frac_part = r % scale;
+                while(decimals > 0 && frac_part % 10 == 0){
+                    frac_part /= 10;
+                    decimals--;
+                }
+                if(signbit(x)){
+                    w->buf[w->len++] = '-';
+                }
+                put_u64(w, int_part, 1);
+                if(decimals > 0){
+                    w->buf[w->len++] = '.';
+                    put_u64(w, frac_part, decimals);
+                }
+                return;
+            }
+        }
+    }
+    int n = snprintf(w->buf + w->len, MAX_NUMBER_LEN, "%g", x);
+    w->len += n < MAX_NUMBER_LEN ? n : MAX_NUMBER_LEN - 1;
+}
+
+void dump_float(struct dump_writer *w, float x){
+    if(w->binary){
+        dump_bytes(w, &x, sizeof(x));
+        return;
+    }
+    dump_fixed(w, x, 6);
+}
+
+void dump_double(struct dump_writer *w, double x){
+    dump_fixed(w, x, 6);
+}
+
+void dump_list(struct dump_writer *w, struct node *head){
+    while(head != NULL){
+        if(w->binary){
+            dump_char(w, (char)head->type);
+        }
+        if(head->type == 0){
+            dump_int(w, *(int *)(head->p_data));
+        }
+        else if(head->type == 1){
+            dump_float(w, *(float *)(head->p_data));
+        }
+        else if(head->type == 2){
+            dump_double(w, *(double *)(head->p_data));
+        }
+        if(!w->binary){
+            dump_char(w, '\n');
+        }
+        head = head->next;
+    }
+}
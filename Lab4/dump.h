@@ -0,0 +1,38 @@
+#if !defined(DUMP)
+#define DUMP
+
+#include <stddef.h>
+#include "linkedlist.h"
+
+// Buffered writer for dumping lots of numbers: values are formatted straight
+// into a big buffer which goes out with one write() per DUMP_BUF_SIZE bytes,
+// instead of one printf per value. In binary mode the raw bytes of each value
+// are written instead of text.
+#define DUMP_BUF_SIZE (1 << 20)
+
+struct dump_writer{
+    int fd;
+    int binary;
+    size_t len;
+    char *buf;
+};
+
+void dump_open(struct dump_writer *w, int fd, int binary);
+void dump_flush(struct dump_writer *w);
+void dump_close(struct dump_writer *w); // flushes, does not close fd
+
+void dump_bytes(struct dump_writer *w, const void *data, size_t n);
+void dump_char(struct dump_writer *w, char c);
+void dump_int(struct dump_writer *w, int x);
+// x with the given number of decimals, like printf("%.*f", decimals, x)
+void dump_fixed(struct dump_writer *w, double x, int decimals);
+// x like printf("%g", x): 6 significant digits, no trailing zeros
+void dump_general(struct dump_writer *w, double x);
+void dump_float(struct dump_writer *w, float x);
+void dump_double(struct dump_writer *w, double x);
+
+// Same output as print_list in text mode; in binary mode each element is a
+// type byte followed by the value.
+void dump_list(struct dump_writer *w, struct node *head);
+
+#endif
@@ -0,0 +1,58 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "linkedlist.h"
+#include "dump.h"
+
+// Prints a 10^6 element list of ints, floats and doubles to stdout with
+// print_list and then with dump_list. Run it as ./dump_bench > /dev/null (or
+// a file); the timings go to stderr.
+#define N 1000000
+
+int main(void){
+    int *ints = (int *)malloc(N * sizeof(int));
+    float *floats = (float *)malloc(N * sizeof(float));
+    double *doubles = (double *)malloc(N * sizeof(double));
+    struct list l;
+    list_init(&l);
+    for(int i = 0; i < N; i++){
+        ints[i] = rand() - RAND_MAX / 2;
+        floats[i] = (float)rand() / 1000;
+        doubles[i] = (double)rand() / 7 - 1000;
+        if(i % 3 == 0){
+            list_append(&l, &ints[i], 0);
+        }
+        else if(i % 3 == 1){
+            list_append(&l, &floats[i], 1);
+        }
+        else{
+            list_append(&l, &doubles[i], 2);
+        }
+    }
+
+    clock_t start = clock();
+    print_list(l.head);
+    fflush(stdout);
+    double t_printf = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    struct dump_writer w;
+    dump_open(&w, 1, 0);
+    dump_list(&w, l.head);
+    dump_close(&w);
+    double t_text = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    start = clock();
+    dump_open(&w, 1, 1);
+    dump_list(&w, l.head);
+    dump_close(&w);
+    double t_binary = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    fprintf(stderr, "print_list %.3f s, dump_list text %.3f s, dump_list binary %.3f s\n",
+            t_printf, t_text, t_binary);
+    list_free(&l);
+    free(ints);
+    free(floats);
+    free(doubles);
+    return 0;
+}
@@ -0,0 +1,139 @@
+#include <stdio.h>
+#include "inline_list.h"
+#include <stdlib.h>
+
+#define BLOCK_NODES 1024
+
+struct pool_block{
+    struct pool_block *next;
+    int used; // nodes handed out from this block so far
+    struct inode nodes[BLOCK_NODES];
+};
+
+void pool_init(struct node_pool *pool){
+    pool->free_nodes = NULL;
+    pool->blocks = NULL;
+}
+
+struct inode *pool_get(struct node_pool *pool, union list_value value, int data_type){
+    struct inode *node;
+    if(pool->free_nodes != NULL){
+        node = pool->free_nodes;
+        pool->free_nodes = node->next;
+    }
+    else{
+        if(pool->blocks == NULL || pool->blocks->used == BLOCK_NODES){
+            struct pool_block *block = (struct pool_block*)malloc(sizeof(struct pool_block));
+            if(block == NULL){
+                return NULL;
+            }
+            block->next = pool->blocks;
+            block->used = 0;
+            pool->blocks = block;
+        }
+        node = &pool->blocks->nodes[pool->blocks->used];
+        pool->blocks->used++;
+    }
+    node->value = value;
+    node->type = data_type;
+    node->next = NULL;
+    return node;
+}
+
+void pool_put(struct node_pool *pool, struct inode *node){
+    node->next = pool->free_nodes;
+    pool->free_nodes = node;
+}
+
+void pool_destroy(struct node_pool *pool){
+    while(pool->blocks != NULL){
+        struct pool_block *next = pool->blocks->next;
+        free(pool->blocks);
+        pool->blocks = next;
+    }
+    pool->free_nodes = NULL;
+}
+
+static int same_value(struct inode *node, union list_value value, int data_type){
+    if(node->type != data_type){
+        return 0;
+    }
+    if(data_type == 0){
+        return node->value.i == value.i;
+    }
+    else if(data_type == 1){
+        return node->value.f == value.f;
+    }
+    return node->value.d == value.d;
+}
+
+// inserts after the node at index pos, like insert in linkedlist.c; returns 0
+// if pos is out of range or the pool is out of memory
+int ilist_insert(struct node_pool *pool, struct inode *head, union list_value value, int pos, int data_type){
+    int p = 0;
+    while(p != pos){
+        head = head->next;
+        p++;
+        if(head == NULL){
+            printf("Error: Index out of Range!\n");
+            return 0;
+        }
+    }
+    struct inode *new_node = pool_get(pool, value, data_type);
+    if(new_node == NULL){
+        printf("Error: Out of memory!\n");
+        return 0;
+    }
+    new_node->next = head->next;
+    head->next = new_node;
+    return 1;
+}
+
+// deletes the first node holding value; returns the (possibly new) head
+struct inode* ilist_del(struct node_pool *pool, struct inode *head, union list_value value, int data_type){
+    struct inode *cur = head;
+    struct inode *prev = NULL;
+    while(cur != NULL){
+        if(same_value(cur, value, data_type)){
+            if(prev == NULL){
+                head = cur->next;
+            }
+            else{
+                prev->next = cur->next;
+            }
+            pool_put(pool, cur);
+            return head;
+        }
+        prev = cur;
+        cur = cur->next;
+    }
+    return head;
+}
+
+void ilist_del2(struct node_pool *pool, struct inode **head, union list_value value, int data_type){
+    *head = ilist_del(pool, *head, value, data_type);
+}
+
+void ilist_free(struct node_pool *pool, struct inode *head){
+    struct inode *cur = head;
+    while(head != NULL){
+        cur = head->next;
+        pool_put(pool, head);
+        head = cur;
+    }
+}
+
+void ilist_print(struct inode *head){
+    while(head != NULL){
+        if(head->type == 0){
+            printf("%d\n", head->value.i);
+        }
+        else if(head->type == 1){
+            printf("%f\n", head->value.f);
+        }
+        else if(head->type == 2){
+            printf("%lf\n", head->value.d);
+        }
+        head = head->next;
+    }
+}
@@ -0,0 +1,43 @@
+#if !defined(INLINE_LIST)
+#define INLINE_LIST
+
+// Same typed list as linkedlist.h, but the value lives inside the node instead
+// of behind a malloc'd p_data, and nodes come from a pool instead of one
+// malloc each.
+
+union list_value{
+    int i;
+    float f;
+    double d;
+};
+
+struct inode{
+    union list_value value;
+    struct inode *next;
+    int type; //0 = int, 1 = float, 2 = double
+};
+
+struct pool_block;
+
+struct node_pool{
+    struct inode *free_nodes;   // nodes given back with pool_put
+    struct pool_block *blocks;  // every block allocated so far
+};
+
+void pool_init(struct node_pool *pool);
+// returns NULL if out of memory
+struct inode *pool_get(struct node_pool *pool, union list_value value, int data_type);
+void pool_put(struct node_pool *pool, struct inode *node);
+void pool_destroy(struct node_pool *pool);
+
+int ilist_insert(struct node_pool *pool, struct inode *head, union list_value value, int pos, int data_type);
+
+struct inode* ilist_del(struct node_pool *pool, struct inode *head, union list_value value, int data_type);
+
+void ilist_del2(struct node_pool *pool, struct inode **head, union list_value value, int data_type);
+
+void ilist_free(struct node_pool *pool, struct inode *head);
+
+void ilist_print(struct inode *head);
+
+#endif
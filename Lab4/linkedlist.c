@@ -119,6 +119,88 @@ void print_list(struct node *head){
     }
 
 }
+
+void list_init(struct list *l){
+    l->head = NULL;
+    l->tail = NULL;
+    l->length = 0;
+}
+
+void list_append(struct list *l, void *data, int data_type){
+    struct node *new_node = (struct node*)malloc(sizeof(struct node));
+    new_node->p_data = data;
+    new_node->next = NULL;
+    new_node->type = data_type;
+
+    if(l->tail == NULL){
+        l->head = new_node;
+    }
+    else{
+        l->tail->next = new_node;
+    }
+    l->tail = new_node;
+    l->length++;
+}
+
+void list_prepend(struct list *l, void *data, int data_type){
+    struct node *new_node = (struct node*)malloc(sizeof(struct node));
+    new_node->p_data = data;
+    new_node->next = l->head;
+    new_node->type = data_type;
+
+    l->head = new_node;
+    if(l->tail == NULL){
+        l->tail = new_node;
+    }
+    l->length++;
+}
+
+// inserts after the node at index pos, like insert; O(1) when that is the tail
+void list_insert(struct list *l, void *data, int pos, int data_type){
+    if(pos < 0 || (size_t)pos >= l->length){
+        printf("Error: Index out of Range!\n");
+        return;
+    }
+    if((size_t)pos == l->length - 1){
+        list_append(l, data, data_type);
+        return;
+    }
+    insert(l->head, data, pos, data_type);
+    l->length++;
+}
+
+void list_del2(struct list *l, void *data){
+    struct node *cur = l->head;
+    struct node *prev = NULL;
+    while(cur != NULL){
+        if(cur->p_data == data){
+            if(prev == NULL){
+                l->head = cur->next;
+            }
+            else{
+                prev->next = cur->next;
+            }
+            if(cur == l->tail){
+                l->tail = prev;
+            }
+            free(cur);
+            l->length--;
+            return;
+        }
+        prev = cur;
+        cur = cur->next;
+    }
+}
+
+size_t list_length(struct list *l){
+    return l->length;
+}
+
+void list_free(struct list *l){
+    free_list(l->head);
+    list_init(l);
+}
+
 /*int main(void){
 
 
@@ -1,6 +1,8 @@
 #if !defined(LINKED_LIST)
 #define LINKED_LIST
 
+#include <stddef.h>
+
 struct node{
     void *p_data;
     struct node *next;
@@ -17,4 +19,27 @@ void free_list(struct node *head);
 
 void print_list(struct node *head);
 
+// A list header that remembers the tail and the length, so appending and
+// asking for the length are O(1). Use the list_* functions on it so that
+// head, tail and length stay consistent.
+struct list{
+    struct node *head;
+    struct node *tail;
+    size_t length;
+};
+
+void list_init(struct list *l);
+
+void list_append(struct list *l, void *data, int data_type);
+
+void list_prepend(struct list *l, void *data, int data_type);
+
+void list_insert(struct list *l, void *data, int pos, int data_type);
+
+void list_del2(struct list *l, void *data);
+
+size_t list_length(struct list *l);
+
+void list_free(struct list *l);
+
 #endif
\ No newline at end of file
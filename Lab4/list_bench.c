@@ -0,0 +1,49 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "linkedlist.h"
+
+// Builds lists of 10^4 .. 10^7 ints by appending, once with the tail pointer
+// in struct list and once the old way (insert after the last index, which
+// walks from head every time). The old way is only run while it is bearable.
+#define OLD_WAY_MAX 100000
+
+int main(void){
+    for(size_t n = 10000; n <= 10000000; n *= 10){
+        int *values = (int *)malloc(n * sizeof(int));
+        for(size_t i = 0; i < n; i++){
+            values[i] = i;
+        }
+
+        clock_t start = clock();
+        struct list l;
+        list_init(&l);
+        for(size_t i = 0; i < n; i++){
+            list_append(&l, &values[i], 0);
+        }
+        double t_tail = (double)(clock() - start) / CLOCKS_PER_SEC;
+        if(list_length(&l) != n || *(int *)(l.tail->p_data) != (int)n - 1){
+            printf("Error: list built wrong!\n");
+        }
+        list_free(&l);
+
+        if(n <= OLD_WAY_MAX){
+            start = clock();
+            struct node *head = (struct node*)malloc(sizeof(struct node));
+            head->p_data = &values[0];
+            head->next = NULL;
+            head->type = 0;
+            for(size_t i = 1; i < n; i++){
+                insert(head, &values[i], i - 1, 0);
+            }
+            double t_walk = (double)(clock() - start) / CLOCKS_PER_SEC;
+            free_list(head);
+            printf("n = %8lu: tail append %.4f s, walk from head %.4f s\n", (unsigned long)n, t_tail, t_walk);
+        }
+        else{
+            printf("n = %8lu: tail append %.4f s, walk from head skipped\n", (unsigned long)n, t_tail);
+        }
+        free(values);
+    }
+    return 0;
+}
@@ -0,0 +1,249 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "list_index.h"
+
+#define MIN_CAPACITY 16
+
+static size_t hash_ptr(void *p, size_t capacity){
+    // malloc'd pointers share their low bits, so mix before masking
+    uint64_t h = (uint64_t)(uintptr_t)p;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    return h & (capacity - 1);
+}
+
+void index_init(struct ptr_index *ix, size_t capacity){
+    size_t cap = MIN_CAPACITY;
+    while(cap < 2 * capacity){
+        cap *= 2;
+    }
+    ix->entries = (struct index_entry *)calloc(cap, sizeof(struct index_entry));
+    ix->capacity = cap;
+    ix->count = 0;
+}
+
+static void index_grow(struct ptr_index *ix){
+    struct index_entry *old = ix->entries;
+    size_t old_cap = ix->capacity;
+    ix->capacity *= 2;
+    ix->entries = (struct index_entry *)calloc(ix->capacity, sizeof(struct index_entry));
+    ix->count = 0;
+    for(size_t i = 0; i < old_cap; i++){
+        if(old[i].key != NULL){
+            index_put(ix, old[i].key, old[i].value);
+        }
+    }
+    free(old);
+}
+
+void index_put(struct ptr_index *ix, void *key, void *value){
+    if(key == NULL){
+        printf("Error: NULL key!\n"); // NULL marks empty slots
+        return;
+    }
+    if(2 * (ix->count + 1) > ix->capacity){
+        index_grow(ix);
+    }
+    size_t i = hash_ptr(key, ix->capacity);
+    while(ix->entries[i].key != NULL && ix->entries[i].key != key){
+        i = (i + 1) & (ix->capacity - 1);
+    }
+    if(ix->entries[i].key == NULL){
+        ix->count++;
+    }
+    ix->entries[i].key = key;
+    ix->entries[i].value = value;
+}
+
+void *index_get(struct ptr_index *ix, void *key){
+    size_t i = hash_ptr(key, ix->capacity);
+    while(ix->entries[i].key != NULL){
+        if(ix->entries[i].key == key){
+            return ix->entries[i].value;
+        }
+        i = (i + 1) & (ix->capacity - 1);
+    }
+    return NULL;
+}
+
+void index_remove(struct ptr_index *ix, void *key){
+    if(key == NULL){
+        return;
+    }
+    size_t mask = ix->capacity - 1;
+    size_t i = hash_ptr(key, ix->capacity);
+    while(ix->entries[i].key != key){
+        if(ix->entries[i].key == NULL){
+            return;
+        }
+        i = (i + 1) & mask;
+    }
+    // shift later entries of the same probe run back instead of leaving a
+    // tombstone, so lookups never have to skip deleted slots
+    size_t j = i;
+    while(1){
+        j = (j + 1) & mask;
+        if(ix->entries[j].key == NULL){
+            break;
+        }
+        size_t home = hash_ptr(ix->entries[j].key, ix->capacity);
+        // the entry at j can fill the hole at i only if its home slot is not
+        // in the (cyclic) range (i, j]
+        if(((j - home) & mask) >= ((j - i) & mask)){
+            ix->entries[i] = ix->entries[j];
+            i = j;
+        }
+    }
+    ix->entries[i].key = NULL;
+    ix->entries[i].value = NULL;
+    ix->count--;
+}
+
+void index_destroy(struct ptr_index *ix){
+    free(ix->entries);
+    ix->entries = NULL;
+    ix->capacity = 0;
+    ix->count = 0;
+}
+
+void dlist_init(struct dlist *l, int indexed){
+    l->head = NULL;
+    l->tail = NULL;
+    l->length = 0;
+    l->indexed = indexed;
+    if(indexed){
+        index_init(&l->index, MIN_CAPACITY);
+    }
+}
+
+static struct dnode *new_dnode(struct dlist *l, void *data, int data_type){
+    if(l->indexed && data == NULL){
+        printf("Error: NULL data!\n");
+        return NULL;
+    }
+    if(l->indexed && index_get(&l->index, data) != NULL){
+        printf("Error: Data already in the list!\n");
+        return NULL;
+    }
+    struct dnode *new_node = (struct dnode*)malloc(sizeof(struct dnode));
+    if(new_node == NULL){
+        printf("Error: Out of memory!\n");
+        return NULL;
+    }
+    new_node->p_data = data;
+    new_node->type = data_type;
+    if(l->indexed){
+        index_put(&l->index, data, new_node);
+    }
+    l->length++;
+    return new_node;
+}
+
+void dlist_append(struct dlist *l, void *data, int data_type){
+    struct dnode *new_node = new_dnode(l, data, data_type);
+    if(new_node == NULL){
+        return;
+    }
+    new_node->prev = l->tail;
+    new_node->next = NULL;
+    if(l->tail == NULL){
+        l->head = new_node;
+    }
+    else{
+        l->tail->next = new_node;
+    }
+    l->tail = new_node;
+}
+
+// inserts after the node at index pos, like insert in linkedlist.c
+void dlist_insert(struct dlist *l, void *data, int pos, int data_type){
+    if(pos < 0 || (size_t)pos >= l->length){
+        printf("Error: Index out of Range!\n");
+        return;
+    }
+    struct dnode *cur = l->head;
+    for(int p = 0; p != pos; p++){
+        cur = cur->next;
+    }
+    if(cur == l->tail){
+        dlist_append(l, data, data_type);
+        return;
+    }
+    struct dnode *new_node = new_dnode(l, data, data_type);
+    if(new_node == NULL){
+        return;
+    }
+    new_node->prev = cur;
+    new_node->next = cur->next;
+    cur->next->prev = new_node;
+    cur->next = new_node;
+}
+
+struct dnode *dlist_find(struct dlist *l, void *data){
+    if(l->indexed){
+        return (struct dnode *)index_get(&l->index, data);
+    }
+    struct dnode *cur = l->head;
+    while(cur != NULL && cur->p_data != data){
+        cur = cur->next;
+    }
+    return cur;
+}
+
+void dlist_remove_node(struct dlist *l, struct dnode *node){
+    if(node->prev == NULL){
+        l->head = node->next;
+    }
+    else{
+        node->prev->next = node->next;
+    }
+    if(node->next == NULL){
+        l->tail = node->prev;
+    }
+    else{
+        node->next->prev = node->prev;
+    }
+    if(l->indexed){
+        index_remove(&l->index, node->p_data);
+    }
+    free(node);
+    l->length--;
+}
+
+void dlist_del2(struct dlist *l, void *data){
+    struct dnode *node = dlist_find(l, data);
+    if(node != NULL){
+        dlist_remove_node(l, node);
+    }
+}
+
+void dlist_free(struct dlist *l){
+    struct dnode *cur = l->head;
+    while(cur != NULL){
+        struct dnode *next = cur->next;
+        free(cur);
+        cur = next;
+    }
+    if(l->indexed){
+        index_destroy(&l->index);
+    }
+    l->head = NULL;
+    l->tail = NULL;
+    l->length = 0;
+}
+
+void dlist_print(struct dlist *l){
+    for(struct dnode *cur = l->head; cur != NULL; cur = cur->next){
+        if(cur->type == 0){
+            printf("%d\n", *(int *)(cur->p_data));
+        }
+        else if(cur->type == 1){
+            printf("%f\n", *(float *)(cur->p_data));
+        }
+        else if(cur->type == 2){
+            printf("%lf\n", *(double *)(cur->p_data));
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#if !defined(LIST_INDEX)
+#define LIST_INDEX
+
+#include <stddef.h>
+
+// Open-addressing hash table from a data pointer to the node holding it.
+// Entries live in one array (linear probing), so adding one never mallocs
+// unless the table has to grow.
+struct index_entry{
+    void *key;   // NULL marks an empty slot
+    void *value;
+};
+
+struct ptr_index{
+    struct index_entry *entries;
+    size_t capacity; // always a power of 2
+    size_t count;
+};
+
+void index_init(struct ptr_index *ix, size_t capacity);
+// key must not be NULL
+void index_put(struct ptr_index *ix, void *key, void *value);
+void *index_get(struct ptr_index *ix, void *key);
+void index_remove(struct ptr_index *ix, void *key);
+void index_destroy(struct ptr_index *ix);
+
+// Doubly-linked version of the typed list in linkedlist.h. With indexed != 0
+// deleting by data pointer is O(1); the index then needs every p_data in the
+// list to be different and not NULL.
+struct dnode{
+    void *p_data;
+    struct dnode *prev;
+    struct dnode *next;
+    int type; //0 = int, 1 = float, 2 = double
+};
+
+struct dlist{
+    struct dnode *head;
+    struct dnode *tail;
+    size_t length;
+    int indexed;
+    struct ptr_index index;
+};
+
+void dlist_init(struct dlist *l, int indexed);
+
+void dlist_append(struct dlist *l, void *data, int data_type);
+
+void dlist_insert(struct dlist *l, void *data, int pos, int data_type);
+
+struct dnode *dlist_find(struct dlist *l, void *data);
+
+void dlist_remove_node(struct dlist *l, struct dnode *node);
+
+void dlist_del2(struct dlist *l, void *data);
+
+void dlist_free(struct dlist *l);
+
+void dlist_print(struct dlist *l);
+
+#endif
@@ -0,0 +1,180 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "search.h"
+
+#define CACHE_LINE 64
+
+size_t search_lower(const int l[], size_t n, int x){
+    if(n == 0){
+        return 0;
+    }
+    const int *base = l;
+    while(n > 1){
+        size_t half = n / 2;
+        base = base[half] < x ? base + half : base;
+        n -= half;
+    }
+    return (base - l) + (*base < x);
+}
+
+size_t search_upper(const int l[], size_t n, int x){
+    if(n == 0){
+        return 0;
+    }
+    const int *base = l;
+    while(n > 1){
+        size_t half = n / 2;
+        base = base[half] <= x ? base + half : base;
+        n -= half;
+    }
+    return (base - l) + (*base <= x);
+}
+
+ptrdiff_t search_first(const int l[], size_t n, int x){
+    size_t i = search_lower(l, n, x);
+    return i < n && l[i] == x ? (ptrdiff_t)i : -1;
+}
+
+ptrdiff_t search_last(const int l[], size_t n, int x){
+    size_t i = search_upper(l, n, x);
+    return i > 0 && l[i-1] == x ? (ptrdiff_t)i - 1 : -1;
+}
+
+static void lower_group(const int l[], size_t n, const int x[], size_t out[]){
+    const int *base[SEARCH_BATCH];
+    for(int g = 0; g < SEARCH_BATCH; g++){
+        base[g] = l;
+    }
+    while(n > 1){
+        size_t half = n / 2;
+        for(int g = 0; g < SEARCH_BATCH; g++){
+            base[g] = base[g][half] < x[g] ? base[g] + half : base[g];
+        }
+        n -= half;
+    }
+    for(int g = 0; g < SEARCH_BATCH; g++){
+        out[g] = (base[g] - l) + (*base[g] < x[g]);
+    }
+}
+
+void search_lower_batch(const int l[], size_t n, const int queries[], size_t n_queries, size_t out[]){
+    size_t q = 0;
+    if(n > 0){
+        for(; q + SEARCH_BATCH <= n_queries; q += SEARCH_BATCH){
+            lower_group(l, n, queries + q, out + q);
+        }
+    }
+    for(; q < n_queries; q++){
+        out[q] = search_lower(l, n, queries[q]);
+    }
+}
+
+/***************************************************************************/
+
+// number of levels in a tree of n nodes
+static int tree_levels(size_t n){
+    return n == 0 ? 0 : 64 - __builtin_clzll((unsigned long long)n);
+}
+
+// Position in sorted order of tree[k] (1 <= k <= n). In a full tree of H
+// levels, each of the o = k - 2^d nodes left of k on its level d brings its
+// subtree of 2^(H-d) - 1 nodes plus the one node that separates it from the
+// next, and then comes k's own left subtree. Our tree only lacks nodes at the
+// end of the last level, which would sit at even positions, so the missing
+// ones in front of k are subtracted.
+static size_t eytz_rank(size_t k, int levels, size_t n){
+    int d = tree_levels(k) - 1;
+    int below = levels - d; // levels in the subtree of k
+    size_t r = ((k - ((size_t)1 << d)) << below) + ((size_t)1 << (below - 1)) - 1;
+    size_t last_present = n + 1 - ((size_t)1 << (levels - 1));
+    size_t last_before = (r + 1) / 2; // last-level slots in front of k
+    return last_before > last_present ? r - (last_before - last_present) : r;
+}
+
+int eytz_build(struct eytzinger *e, const int sorted[], size_t n){
+    e->block = malloc((n + 1) * sizeof(int) + CACHE_LINE);
+    if(e->block == NULL){
+        printf("Error: Out of memory!\n");
+        e->tree = NULL;
+        e->n = 0;
+        return 0;
+    }
+    e->tree = (int *)(((uintptr_t)e->block + CACHE_LINE - 1) & ~(uintptr_t)(CACHE_LINE - 1));
+    e->n = n;
+    int levels = tree_levels(n);
+    for(size_t k = 1; k <= n; k++){
+        e->tree[k] = sorted[eytz_rank(k, levels, n)];
+    }
+    return 1;
+}
+
+void eytz_free(struct eytzinger *e){
+    free(e->block);
+    e->block = NULL;
+    e->tree = NULL;
+    e->n = 0;
+}
+
+// A search descends until it falls off the tree; the answer is the last node
+// where it went left, i.e. k with its trailing 1 bits and one 0 shifted off.
+// 0 means it never went left and there is no answer.
+static size_t eytz_answer(size_t k, size_t n){
+    k >>= __builtin_ffsll(~(unsigned long long)k);
+    return k == 0 ? n : eytz_rank(k, tree_levels(n), n);
+}
+
+size_t eytz_lower(const struct eytzinger *e, int x){
+    const int *t = e->tree;
+    size_t n = e->n;
+    size_t k = 1;
+    while(k <= n){
+        // tree[16k..16k+15], four levels down, is one cache line
+        __builtin_prefetch(t + 16 * k);
+        k = 2 * k + (t[k] < x);
+    }
+    return eytz_answer(k, n);
+}
+
+size_t eytz_upper(const struct eytzinger *e, int x){
+    const int *t = e->tree;
+    size_t n = e->n;
+    size_t k = 1;
+    while(k <= n){
+        __builtin_prefetch(t + 16 * k);
+        k = 2 * k + (t[k] <= x);
+    }
+    return eytz_answer(k, n);
+}
+
+static void eytz_group(const int t[], size_t n, int levels, const int x[], size_t out[]){
+    size_t k[SEARCH_BATCH];
+    for(int g = 0; g < SEARCH_BATCH; g++){
+        k[g] = 1;
+    }
+    // all levels but the last are full, so every search takes these steps
+    for(int level = 1; level < levels; level++){
+        for(int g = 0; g < SEARCH_BATCH; g++){
+            __builtin_prefetch(t + 16 * k[g]);
+            k[g] = 2 * k[g] + (t[k[g]] < x[g]);
+        }
+    }
+    for(int g = 0; g < SEARCH_BATCH; g++){
+        size_t kg = k[g];
+        if(kg <= n){
+            kg = 2 * kg + (t[kg] < x[g]);
+        }
+        out[g] = eytz_answer(kg, n);
+    }
+}
+
+void eytz_lower_batch(const struct eytzinger *e, const int queries[], size_t n_queries, size_t out[]){
+    int levels = tree_levels(e->n);
+    size_t q = 0;
+    for(; q + SEARCH_BATCH <= n_queries; q += SEARCH_BATCH){
+        eytz_group(e->tree, e->n, levels, queries + q, out + q);
+    }
+    for(; q < n_queries; q++){
+        out[q] = eytz_lower(e, queries[q]);
+    }
+}
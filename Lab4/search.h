@@ -0,0 +1,47 @@
+#if !defined(SEARCH)
+#define SEARCH
+
+#include <stddef.h>
+
+// Binary search over large sorted int arrays, the C counterpart of find and
+// find_max in lab4.py. Each step halves the range whatever the comparison
+// says, so the only data-dependent thing is a conditional move and the CPU
+// never mispredicts. On arrays bigger than the cache every step is then a
+// cache miss, which the batched search and the Eytzinger layout below hide.
+
+// first index whose element is >= x (lower) or > x (upper), n if none
+size_t search_lower(const int l[], size_t n, int x);
+size_t search_upper(const int l[], size_t n, int x);
+
+// index of the first / last element equal to x, -1 if there is none
+// (what find and find_max in lab4.py return)
+ptrdiff_t search_first(const int l[], size_t n, int x);
+ptrdiff_t search_last(const int l[], size_t n, int x);
+
+// search_lower for n_queries values at once. Every search over the same n
+// takes the same number of steps, so SEARCH_BATCH of them advance together
+// and their cache misses overlap instead of waiting on each other.
+#define SEARCH_BATCH 16
+void search_lower_batch(const int l[], size_t n, const int queries[], size_t n_queries, size_t out[]);
+
+// The same array stored in breadth-first (Eytzinger) order: the root at
+// tree[1], the children of tree[k] at tree[2k] and tree[2k+1]. The first
+// levels of every search share a few cache lines, and the 16 descendants
+// four levels below a node are adjacent, so one prefetch per step fetches
+// them all. Costs a copy of the array.
+struct eytzinger{
+    int *tree; // n + 1 ints, cache-line aligned, tree[0] unused
+    size_t n;
+    void *block; // what malloc returned
+};
+
+// returns 0 if out of memory
+int eytz_build(struct eytzinger *e, const int sorted[], size_t n);
+void eytz_free(struct eytzinger *e);
+
+// same results as search_lower / search_upper on the sorted array
+size_t eytz_lower(const struct eytzinger *e, int x);
+size_t eytz_upper(const struct eytzinger *e, int x);
+void eytz_lower_batch(const struct eytzinger *e, const int queries[], size_t n_queries, size_t out[]);
+
+#endif
@@ -0,0 +1,93 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "search.h"
+
+// N_QUERIES random lower-bound searches in sorted arrays from 32 KB (L1) to
+// 1 GB, comparing find from lab4.py written in C (it branches on every
+// comparison), the branch-free search one at a time and batched, and the
+// Eytzinger layout one at a time and batched.
+// Prints ns per query.
+#define N_QUERIES 1000000
+#define N_WAYS 5
+
+// find from lab4.py, returning the lower bound instead of the match
+size_t find_lower(const int l[], size_t n, int e){
+    size_t lo = 0;
+    size_t hi = n;
+    while(lo < hi){
+        size_t mid = (lo + hi) / 2;
+        if(e <= l[mid]){
+            hi = mid;
+        }
+        else{
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
+
+int main(){
+    const char *names[N_WAYS] = {"find", "branchless", "batch", "eytzinger", "eytz batch"};
+    int *queries = (int *)malloc(N_QUERIES * sizeof(int));
+    size_t *out = (size_t *)malloc(N_QUERIES * sizeof(size_t));
+    size_t *expect = (size_t *)malloc(N_QUERIES * sizeof(size_t));
+    printf("%10s", "size");
+    for(int w = 0; w < N_WAYS; w++){
+        printf(" %11s", names[w]);
+    }
+    printf("   (ns per query)\n");
+    srand(1);
+    for(size_t bytes = (size_t)32 << 10; bytes <= (size_t)1 << 30; bytes *= 8){
+        size_t n = bytes / sizeof(int);
+        int *l = (int *)malloc(n * sizeof(int));
+        if(l == NULL){
+            printf("Error: Out of memory!\n");
+            return 1;
+        }
+        for(size_t i = 0; i < n; i++){
+            l[i] = 2 * (int)i;
+        }
+        struct eytzinger e;
+        if(!eytz_build(&e, l, n)){
+            return 1;
+        }
+        for(int q = 0; q < N_QUERIES; q++){
+            queries[q] = (int)(((size_t)rand() * (RAND_MAX + 1u) + rand()) % (2 * n));
+        }
+        printf("%8zuKB", bytes >> 10);
+        int ok = 1;
+        for(int w = 0; w < N_WAYS; w++){
+            clock_t start = clock();
+            if(w == 2){
+                search_lower_batch(l, n, queries, N_QUERIES, out);
+            }
+            else if(w == 4){
+                eytz_lower_batch(&e, queries, N_QUERIES, out);
+            }
+            else{
+                for(int q = 0; q < N_QUERIES; q++){
+                    int x = queries[q];
+                    out[q] = w == 0 ? find_lower(l, n, x) : w == 1 ? search_lower(l, n, x) : eytz_lower(&e, x);
+                }
+            }
+            double secs = (double)(clock() - start) / CLOCKS_PER_SEC;
+            printf(" %11.1f", secs / N_QUERIES * 1e9);
+            for(int q = 0; q < N_QUERIES; q++){
+                if(w == 0){
+                    expect[q] = out[q];
+                }
+                else if(out[q] != expect[q]){
+                    ok = 0;
+                }
+            }
+        }
+        printf("%s\n", ok ? "" : "   WRONG");
+        eytz_free(&e);
+        free(l);
+    }
+    free(expect);
+    free(out);
+    free(queries);
+    return 0;
+}
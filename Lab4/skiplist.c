@@ -0,0 +1,191 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "skiplist.h"
+
+static struct skip_node *new_skip_node(int level, void *data, int data_type){
+    struct skip_node *node = (struct skip_node*)malloc(sizeof(struct skip_node) + level * sizeof(struct skip_link));
+    node->p_data = data;
+    node->type = data_type;
+    node->level = level;
+    for(int i = 0; i < level; i++){
+        node->links[i].next = NULL;
+        node->links[i].span = 0;
+    }
+    return node;
+}
+
+// level i+1 with probability 1/4 of level i
+static int random_level(struct skip_list *sl){
+    int level = 1;
+    while(level < SKIP_MAX_LEVEL){
+        sl->seed ^= sl->seed << 13;
+        sl->seed ^= sl->seed >> 17;
+        sl->seed ^= sl->seed << 5;
+        if((sl->seed & 3) != 0){
+            break;
+        }
+        level++;
+    }
+    return level;
+}
+
+void skip_init(struct skip_list *sl){
+    sl->head = new_skip_node(SKIP_MAX_LEVEL, NULL, 0);
+    sl->level = 1;
+    sl->length = 0;
+    sl->seed = 2463534242u;
+    index_init(&sl->index, 0);
+}
+
+// Fills update[i] with the last node at level i whose position is <= pos
+// (position 0 is the head sentinel, position 1 the first element) and rank[i]
+// with that node's position.
+static void find_before(struct skip_list *sl, size_t pos, struct skip_node **update, size_t *rank){
+    struct skip_node *x = sl->head;
+    for(int i = sl->level - 1; i >= 0; i--){
+        rank[i] = i == sl->level - 1 ? 0 : rank[i + 1];
+        while(x->links[i].next != NULL && rank[i] + x->links[i].span <= pos){
+            rank[i] += x->links[i].span;
+            x = x->links[i].next;
+        }
+        update[i] = x;
+    }
+}
+
+void skip_insert_at(struct skip_list *sl, void *data, size_t pos, int data_type){
+    if(pos > sl->length){
+        printf("Error: Index out of Range!\n");
+        return;
+    }
+    if(data == NULL){
+        printf("Error: NULL data!\n");
+        return;
+    }
+    if(index_get(&sl->index, data) != NULL){
+        printf("Error: Data already in the list!\n");
+        return;
+    }
+    struct skip_node *update[SKIP_MAX_LEVEL];
+    size_t rank[SKIP_MAX_LEVEL];
+    find_before(sl, pos, update, rank);
+
+    int level = random_level(sl);
+    if(level > sl->level){
+        for(int i = sl->level; i < level; i++){
+            rank[i] = 0;
+            update[i] = sl->head;
+            update[i]->links[i].span = sl->length;
+        }
+        sl->level = level;
+    }
+
+    struct skip_node *node = new_skip_node(level, data, data_type);
+    for(int i = 0; i < level; i++){
+        node->links[i].next = update[i]->links[i].next;
+        update[i]->links[i].next = node;
+        node->links[i].span = update[i]->links[i].span - (rank[0] - rank[i]);
+        update[i]->links[i].span = (rank[0] - rank[i]) + 1;
+    }
+    for(int i = level; i < sl->level; i++){
+        update[i]->links[i].span++;
+    }
+    index_put(&sl->index, data, node);
+    sl->length++;
+}
+
+struct skip_node *skip_get(struct skip_list *sl, size_t pos){
+    if(pos >= sl->length){
+        printf("Error: Index out of Range!\n");
+        return NULL;
+    }
+    struct skip_node *x = sl->head;
+    size_t rank = 0;
+    for(int i = sl->level - 1; i >= 0; i--){
+        while(x->links[i].next != NULL && rank + x->links[i].span <= pos + 1){
+            rank += x->links[i].span;
+            x = x->links[i].next;
+        }
+        if(rank == pos + 1){
+            return x;
+        }
+    }
+    return NULL;
+}
+
+void skip_del_at(struct skip_list *sl, size_t pos){
+    if(pos >= sl->length){
+        printf("Error: Index out of Range!\n");
+        return;
+    }
+    struct skip_node *update[SKIP_MAX_LEVEL];
+    size_t rank[SKIP_MAX_LEVEL];
+    find_before(sl, pos, update, rank);
+
+    struct skip_node *x = update[0]->links[0].next;
+    for(int i = 0; i < sl->level; i++){
+        if(update[i]->links[i].next == x){
+            update[i]->links[i].span += x->links[i].span - 1;
+            update[i]->links[i].next = x->links[i].next;
+        }
+        else{
+            update[i]->links[i].span--;
+        }
+    }
+    while(sl->level > 1 && sl->head->links[sl->level - 1].next == NULL){
+        sl->level--;
+    }
+    index_remove(&sl->index, x->p_data);
+    free(x);
+    sl->length--;
+}
+
+// Index of x. The top link of a node leads to the next node at least as
+// tall, so following top links from x to the last element retraces a search
+// path backwards: O(log n) expected steps. A link out of the last node at a
+// level spans the elements left after that node.
+static size_t skip_index_of(struct skip_list *sl, struct skip_node *x){
+    size_t after = 0;
+    while(1){
+        struct skip_link *top = &x->links[x->level - 1];
+        after += top->span;
+        if(top->next == NULL){
+            break;
+        }
+        x = top->next;
+    }
+    return sl->length - 1 - after;
+}
+
+void skip_del2(struct skip_list *sl, void *data){
+    struct skip_node *x = (struct skip_node *)index_get(&sl->index, data);
+    if(x != NULL){
+        skip_del_at(sl, skip_index_of(sl, x));
+    }
+}
+
+void skip_free(struct skip_list *sl){
+    struct skip_node *x = sl->head;
+    while(x != NULL){
+        struct skip_node *next = x->links[0].next;
+        free(x);
+        x = next;
+    }
+    index_destroy(&sl->index);
+    sl->head = NULL;
+    sl->level = 0;
+    sl->length = 0;
+}
+
+void skip_print(struct skip_list *sl){
+    for(struct skip_node *x = sl->head->links[0].next; x != NULL; x = x->links[0].next){
+        if(x->type == 0){
+            printf("%d\n", *(int *)(x->p_data));
+        }
+        else if(x->type == 1){
+            printf("%f\n", *(float *)(x->p_data));
+        }
+        else if(x->type == 2){
+            printf("%lf\n", *(double *)(x->p_data));
+        }
+    }
+}
@@ -0,0 +1,51 @@
+#if !defined(SKIP_LIST)
+#define SKIP_LIST
+
+#include <stddef.h>
+#include "list_index.h"
+
+// Indexable skip list holding the same (p_data, type) elements as linkedlist.h.
+// Every link also stores its span -- how many elements it jumps over -- so
+// the element at any index is found in O(log n) expected steps. A ptr_index
+// maps each p_data to its node, so deleting by pointer is O(log n) as well;
+// like an indexed dlist, every p_data in the list must be different (and not
+// NULL).
+#define SKIP_MAX_LEVEL 32
+
+struct skip_link{
+    struct skip_node *next;
+    size_t span;
+};
+
+struct skip_node{
+    void *p_data;
+    int type; //0 = int, 1 = float, 2 = double
+    int level;
+    struct skip_link links[]; // level entries
+};
+
+struct skip_list{
+    struct skip_node *head; // sentinel, holds no data
+    int level;
+    size_t length;
+    unsigned int seed;
+    struct ptr_index index; // p_data -> node
+};
+
+void skip_init(struct skip_list *sl);
+
+// inserts so that the new element ends up at index pos (0 <= pos <= length)
+void skip_insert_at(struct skip_list *sl, void *data, size_t pos, int data_type);
+
+struct skip_node *skip_get(struct skip_list *sl, size_t pos);
+
+void skip_del_at(struct skip_list *sl, size_t pos);
+
+// deletes the node whose p_data is data
+void skip_del2(struct skip_list *sl, void *data);
+
+void skip_free(struct skip_list *sl);
+
+void skip_print(struct skip_list *sl);
+
+#endif
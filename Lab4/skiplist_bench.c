@@ -0,0 +1,64 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "linkedlist.h"
+#include "skiplist.h"
+
+// Inserts at random positions into a list that already holds n ints, with
+// insert from linkedlist.c (walks pos nodes) and with the skip list, then
+// deletes N_DELETES random elements by pointer with del2 (a scan) and
+// skip_del2. The skip list needs a different pointer per element.
+#define N_INSERTS 10000
+#define N_DELETES 1000
+
+int main(void){
+    for(size_t n = 100000; n <= 1000000; n *= 10){
+        int *values = (int *)malloc((n + N_INSERTS) * sizeof(int));
+        for(size_t i = 0; i < n + N_INSERTS; i++){
+            values[i] = (int)i;
+        }
+        srand(1);
+        struct list l;
+        list_init(&l);
+        for(size_t i = 0; i < n; i++){
+            list_append(&l, &values[i], 0);
+        }
+        clock_t start = clock();
+        for(int k = 0; k < N_INSERTS; k++){
+            insert(l.head, &values[n + k], rand() % l.length, 0);
+            l.length++;
+        }
+        double t_list = (double)(clock() - start) / CLOCKS_PER_SEC;
+        start = clock();
+        for(int k = 0; k < N_DELETES; k++){
+            del2(&l.head, &values[rand() % (n + N_INSERTS)]);
+        }
+        double t_list_del = (double)(clock() - start) / CLOCKS_PER_SEC;
+        free_list(l.head);
+
+        srand(1);
+        struct skip_list sl;
+        skip_init(&sl);
+        for(size_t i = 0; i < n; i++){
+            skip_insert_at(&sl, &values[i], i, 0);
+        }
+        start = clock();
+        for(int k = 0; k < N_INSERTS; k++){
+            skip_insert_at(&sl, &values[n + k], rand() % (sl.length + 1), 0);
+        }
+        double t_skip = (double)(clock() - start) / CLOCKS_PER_SEC;
+        start = clock();
+        for(int k = 0; k < N_DELETES; k++){
+            skip_del2(&sl, &values[rand() % (n + N_INSERTS)]);
+        }
+        double t_skip_del = (double)(clock() - start) / CLOCKS_PER_SEC;
+        skip_free(&sl);
+        free(values);
+
+        printf("n = %7lu, %d random inserts: linked list %.3f s, skip list %.4f s\n",
+               (unsigned long)n, N_INSERTS, t_list, t_skip);
+        printf("            %d deletes by pointer: linked list %.3f s, skip list %.4f s\n",
+               N_DELETES, t_list_del, t_skip_del);
+    }
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "snapshot.h"
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#define SLOT_SIZE 8
+
+// 8 bytes per step: xor the word in, multiply, rotate
+uint64_t snapshot_checksum(const void *data, size_t len){
+    const unsigned char *p = (const unsigned char *)data;
+    uint64_t h = 0xcbf29ce484222325ULL ^ len;
+    size_t i = 0;
+    for(; i + 8 <= len; i += 8){
+        uint64_t word;
+        memcpy(&word, p + i, 8);
+        h = (h ^ word) * 0x100000001b3ULL;
+        h = (h << 29) | (h >> 35);
+    }
+    for(; i < len; i++){
+        h = (h ^ p[i]) * 0x100000001b3ULL;
+    }
+    return h;
+}
+
+size_t snapshot_type_size(uint32_t elem_type){
+    if(elem_type == SNAPSHOT_INT){
+        return sizeof(int);
+    }
+    else if(elem_type == SNAPSHOT_FLOAT){
+        return sizeof(float);
+    }
+    else if(elem_type == SNAPSHOT_DOUBLE){
+        return sizeof(double);
+    }
+    return 0;
+}
+
+int snapshot_write(const char *filename, const char *magic, uint32_t elem_size, uint32_t elem_type,
+                   uint64_t count, const void *payload, size_t payload_len){
+    struct snapshot_header header;
+    memcpy(header.magic, magic, 4);
+    header.elem_size = elem_size;
+    header.elem_type = elem_type;
+    header.reserved = 0;
+    header.count = count;
+    header.checksum = snapshot_checksum(payload, payload_len);
+
+    FILE *fp = fopen(filename, "wb");
+    if(fp == NULL){
+        printf("Error: Could not open %s!\n", filename);
+        return 0;
+    }
+    int ok = fwrite(&header, sizeof(header), 1, fp) == 1
+          && fwrite(payload, 1, payload_len, fp) == payload_len;
+    ok = fclose(fp) == 0 && ok;
+    return ok;
+}
+
+void *snapshot_map(const char *filename, size_t *len){
+#if defined(_WIN32)
+    FILE *fp = fopen(filename, "rb");
+    if(fp == NULL){
+        return NULL;
+    }
+    fseek(fp, 0, SEEK_END);
+    *len = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    void *data = malloc(*len);
+    if(data != NULL && fread(data, 1, *len, fp) != *len){
+        free(data);
+        data = NULL;
+    }
+    fclose(fp);
+    return data;
+#else
+    int fd = open(filename, O_RDONLY);
+    if(fd < 0){
+        return NULL;
+    }
+    struct stat st;
+    if(fstat(fd, &st) != 0 || st.st_size == 0){
+        close(fd);
+        return NULL;
+    }
+    *len = st.st_size;
+    void *data = mmap(NULL, *len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    return data == MAP_FAILED ? NULL : data;
+#endif
+}
+
+void snapshot_unmap(void *data, size_t len){
+#if defined(_WIN32)
+    free(data);
+#else
+    munmap(data, len);
+#endif
+}
+
+void *snapshot_payload(void *data, size_t len, const char *magic, uint32_t elem_type,
+                       struct snapshot_header *header){
+    if(data == NULL || len < sizeof(struct snapshot_header)){
+        return NULL;
+    }
+    memcpy(header, data, sizeof(struct snapshot_header));
+    size_t payload_len = len - sizeof(struct snapshot_header);
+    void *payload = (char *)data + sizeof(struct snapshot_header);
+    if(memcmp(header->magic, magic, 4) == 0 && header->elem_type != elem_type){
+        printf("Error: Snapshot holds another element type!\n");
+        return NULL;
+    }
+    size_t type_size = snapshot_type_size(elem_type);
+    if(memcmp(header->magic, magic, 4) != 0 || header->elem_size == 0
+       || (type_size != 0 && header->elem_size != type_size)
+       || header->count > payload_len / header->elem_size
+       || snapshot_checksum(payload, payload_len) != header->checksum){
+        printf("Error: Bad snapshot!\n");
+        return NULL;
+    }
+    return payload;
+}
+
+int list_save(struct list *l, const char *filename){
+    size_t n = l->length;
+    size_t payload_len = n * (SLOT_SIZE + 1);
+    unsigned char *payload = (unsigned char *)calloc(payload_len > 0 ? payload_len : 1, 1);
+    if(payload == NULL){
+        return 0;
+    }
+    unsigned char *types = payload + n * SLOT_SIZE;
+    size_t i = 0;
+    for(struct node *cur = l->head; cur != NULL; cur = cur->next, i++){
+        size_t size = cur->type == 0 ? sizeof(int) : cur->type == 1 ? sizeof(float) : sizeof(double);
+        memcpy(payload + i * SLOT_SIZE, cur->p_data, size);
+        types[i] = cur->type;
+    }
+    int ok = snapshot_write(filename, "LST2", SLOT_SIZE, SNAPSHOT_MIXED, n, payload, payload_len);
+    free(payload);
+    return ok;
+}
+
+int list_load_mem(struct list *l, void *data, size_t len){
+    struct snapshot_header header;
+    unsigned char *payload = (unsigned char *)snapshot_payload(data, len, "LST2", SNAPSHOT_MIXED, &header);
+    list_init(l);
+    if(payload == NULL || header.elem_size != SLOT_SIZE
+       || header.count * (SLOT_SIZE + 1) > len - sizeof(struct snapshot_header)){
+        return 0;
+    }
+    unsigned char *types = payload + header.count * SLOT_SIZE;
+    for(uint64_t i = 0; i < header.count; i++){
+        if(types[i] > SNAPSHOT_DOUBLE){
+            printf("Error: Bad snapshot!\n");
+            return 0;
+        }
+    }
+    for(uint64_t i = 0; i < header.count; i++){
+        list_append(l, payload + i * SLOT_SIZE, types[i]);
+    }
+    return 1;
+}
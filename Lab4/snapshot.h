@@ -0,0 +1,55 @@
+#if !defined(SNAPSHOT)
+#define SNAPSHOT
+
+#include <stddef.h>
+#include <stdint.h>
+#include "linkedlist.h"
+
+// Binary snapshot files: a header followed by the packed elements. The
+// elements start 32 bytes into the file, so a mapped file can be used in
+// place (8-byte aligned) without parsing anything per element.
+struct snapshot_header{
+    char magic[4];      // "BAG2" or "LST2"
+    uint32_t elem_size; // bytes per element slot
+    uint32_t elem_type; // one of the SNAPSHOT_ types below
+    uint32_t reserved;  // 0
+    uint64_t count;
+    uint64_t checksum;  // snapshot_checksum of everything after the header
+};
+
+// Element types, numbered like the type field of struct node. List
+// snapshots are SNAPSHOT_MIXED and store a type byte per element. Other
+// element types (of bags) can use numbers from SNAPSHOT_USER up.
+#define SNAPSHOT_INT 0
+#define SNAPSHOT_FLOAT 1
+#define SNAPSHOT_DOUBLE 2
+#define SNAPSHOT_MIXED 3
+#define SNAPSHOT_USER 16
+
+// size of an element of type 0 .. 2, 0 for any other type
+size_t snapshot_type_size(uint32_t elem_type);
+
+uint64_t snapshot_checksum(const void *data, size_t len);
+
+// Writes header + payload to filename; returns 1 on success.
+int snapshot_write(const char *filename, const char *magic, uint32_t elem_size, uint32_t elem_type,
+                   uint64_t count, const void *payload, size_t payload_len);
+
+// Maps a whole file (copy-on-write, so writes through it never reach the
+// file); returns NULL on failure.
+void *snapshot_map(const char *filename, size_t *len);
+void snapshot_unmap(void *data, size_t len);
+
+// Checks magic, element type, size and checksum of a mapped snapshot;
+// returns a pointer to the payload or NULL.
+void *snapshot_payload(void *data, size_t len, const char *magic, uint32_t elem_type,
+                       struct snapshot_header *header);
+
+// List snapshots: count 8-byte value slots, then count type bytes.
+int list_save(struct list *l, const char *filename);
+
+// Rebuilds l with every p_data pointing into data, which must stay mapped
+// until the list is freed. Returns 1 on success.
+int list_load_mem(struct list *l, void *data, size_t len);
+
+#endif
@@ -0,0 +1,210 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unrolled_list.h"
+
+static struct chunk *new_chunk(struct chunk *next){
+    struct chunk *c = (struct chunk*)malloc(sizeof(struct chunk));
+    if(c == NULL){
+        printf("Error: Out of memory!\n");
+        return NULL;
+    }
+    c->next = next;
+    c->count = 0;
+    return c;
+}
+
+// moves values[from..count) of c one slot to the right or left
+static void shift_right(struct chunk *c, int from){
+    memmove(&c->values[from + 1], &c->values[from], (c->count - from) * sizeof(union list_value));
+    memmove(&c->types[from + 1], &c->types[from], c->count - from);
+}
+
+static void shift_left(struct chunk *c, int from){
+    memmove(&c->values[from], &c->values[from + 1], (c->count - from - 1) * sizeof(union list_value));
+    memmove(&c->types[from], &c->types[from + 1], c->count - from - 1);
+}
+
+void ulist_init(struct unrolled_list *l){
+    l->head = NULL;
+    l->length = 0;
+}
+
+int ulist_insert(struct unrolled_list *l, union list_value value, size_t pos, int data_type){
+    if(pos > l->length){
+        printf("Error: Index out of Range!\n");
+        return 0;
+    }
+    if(l->head == NULL){
+        l->head = new_chunk(NULL);
+        if(l->head == NULL){
+            return 0;
+        }
+    }
+
+    // find the chunk holding index pos; an index one past a chunk's last value
+    // goes at the end of that chunk
+    struct chunk *c = l->head;
+    while(pos > (size_t)c->count){
+        pos -= c->count;
+        c = c->next;
+    }
+
+    if(c->count == CHUNK_CAP && pos == CHUNK_CAP && c->next == NULL){
+        // appending to a full last chunk starts a new one, so that appends
+        // leave every chunk full instead of half full
+        c->next = new_chunk(NULL);
+        if(c->next == NULL){
+            return 0;
+        }
+        c = c->next;
+        pos = 0;
+    }
+    else if(c->count == CHUNK_CAP && pos == CHUNK_CAP && c->next->count < CHUNK_CAP){
+        c = c->next;
+        pos = 0;
+    }
+    else if(c->count == CHUNK_CAP){
+        // split: the upper half moves to a new chunk after c
+        struct chunk *upper = new_chunk(c->next);
+        if(upper == NULL){
+            return 0;
+        }
+        int half = CHUNK_CAP / 2;
+        upper->count = CHUNK_CAP - half;
+        memcpy(upper->values, &c->values[half], upper->count * sizeof(union list_value));
+        memcpy(upper->types, &c->types[half], upper->count);
+        c->count = half;
+        c->next = upper;
+        if(pos > (size_t)half){
+            pos -= half;
+            c = upper;
+        }
+    }
+
+    shift_right(c, pos);
+    c->values[pos] = value;
+    c->types[pos] = data_type;
+    c->count++;
+    l->length++;
+    return 1;
+}
+
+static int same_value(struct chunk *c, int i, union list_value value, int data_type){
+    if(c->types[i] != data_type){
+        return 0;
+    }
+    if(data_type == 0){
+        return c->values[i].i == value.i;
+    }
+    else if(data_type == 1){
+        return c->values[i].f == value.f;
+    }
+    return c->values[i].d == value.d;
+}
+
+// moves all values of b (which follows a) to the end of a and frees b
+static void merge_chunks(struct chunk *a, struct chunk *b){
+    memcpy(&a->values[a->count], b->values, b->count * sizeof(union list_value));
+    memcpy(&a->types[a->count], b->types, b->count);
+    a->count += b->count;
+    a->next = b->next;
+    free(b);
+}
+
+// After a delete left c (preceded by prev, NULL at the head) less than half
+// full: merge it with a neighbour if both fit in one chunk, else borrow one
+// value from that neighbour, which has more than half to spare. Every chunk
+// but the last stays at least half full, so scans read whole cache lines.
+static void refill(struct unrolled_list *l, struct chunk *prev, struct chunk *c){
+    if(c->next != NULL){
+        struct chunk *next = c->next;
+        if(c->count + next->count <= CHUNK_CAP){
+            merge_chunks(c, next);
+            return;
+        }
+        c->values[c->count] = next->values[0];
+        c->types[c->count] = next->types[0];
+        c->count++;
+        shift_left(next, 0);
+        next->count--;
+    }
+    else if(prev != NULL){
+        if(prev->count + c->count <= CHUNK_CAP){
+            merge_chunks(prev, c);
+            return;
+        }
+        shift_right(c, 0);
+        c->values[0] = prev->values[prev->count - 1];
+        c->types[0] = prev->types[prev->count - 1];
+        c->count++;
+        prev->count--;
+    }
+    else if(c->count == 0){
+        l->head = NULL;
+        free(c);
+    }
+}
+
+int ulist_del(struct unrolled_list *l, union list_value value, int data_type){
+    struct chunk *prev = NULL;
+    struct chunk *c = l->head;
+    while(c != NULL){
+        for(int i = 0; i < c->count; i++){
+            if(!same_value(c, i, value, data_type)){
+                continue;
+            }
+            shift_left(c, i);
+            c->count--;
+            l->length--;
+            if(c->count < CHUNK_CAP / 2){
+                refill(l, prev, c);
+            }
+            return 1;
+        }
+        prev = c;
+        c = c->next;
+    }
+    return 0;
+}
+
+int ulist_get(struct unrolled_list *l, size_t pos, union list_value *value, int *data_type){
+    if(pos >= l->length){
+        printf("Error: Index out of Range!\n");
+        return 0;
+    }
+    struct chunk *c = l->head;
+    while(pos >= (size_t)c->count){
+        pos -= c->count;
+        c = c->next;
+    }
+    *value = c->values[pos];
+    *data_type = c->types[pos];
+    return 1;
+}
+
+void ulist_free(struct unrolled_list *l){
+    struct chunk *c = l->head;
+    while(c != NULL){
+        struct chunk *next = c->next;
+        free(c);
+        c = next;
+    }
+    ulist_init(l);
+}
+
+void ulist_print(struct unrolled_list *l){
+    for(struct chunk *c = l->head; c != NULL; c = c->next){
+        for(int i = 0; i < c->count; i++){
+            if(c->types[i] == 0){
+                printf("%d\n", c->values[i].i);
+            }
+            else if(c->types[i] == 1){
+                printf("%f\n", c->values[i].f);
+            }
+            else if(c->types[i] == 2){
+                printf("%lf\n", c->values[i].d);
+            }
+        }
+    }
+}
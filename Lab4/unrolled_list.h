@@ -0,0 +1,40 @@
+#if !defined(UNROLLED_LIST)
+#define UNROLLED_LIST
+
+#include <stddef.h>
+#include "inline_list.h"
+
+// Each chunk holds up to CHUNK_CAP typed values next to each other, so a scan
+// touches one next pointer per CHUNK_CAP values. 12 values keep a chunk
+// within two 64-byte cache lines. Deleting keeps every chunk but the last at
+// least half full, by borrowing from or merging with a neighbour.
+#define CHUNK_CAP 12
+
+struct chunk{
+    struct chunk *next;
+    int count;
+    signed char types[CHUNK_CAP]; //0 = int, 1 = float, 2 = double
+    union list_value values[CHUNK_CAP];
+};
+
+struct unrolled_list{
+    struct chunk *head;
+    size_t length;
+};
+
+void ulist_init(struct unrolled_list *l);
+
+// inserts so that the new value ends up at index pos (0 <= pos <= length);
+// returns 0 if pos is out of range or out of memory
+int ulist_insert(struct unrolled_list *l, union list_value value, size_t pos, int data_type);
+
+// deletes the first element equal to value; returns 1 if one was deleted
+int ulist_del(struct unrolled_list *l, union list_value value, int data_type);
+
+int ulist_get(struct unrolled_list *l, size_t pos, union list_value *value, int *data_type);
+
+void ulist_free(struct unrolled_list *l);
+
+void ulist_print(struct unrolled_list *l);
+
+#endif
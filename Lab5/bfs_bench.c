@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "graph.h"
+#include "graph_gen.h"
+#include "parallel_bfs.h"
+
+// Searches an R-MAT graph (scale from the command line, default 20, with 16
+// edges per node) and a square grid of about as many nodes from N_SOURCES
+// random nodes, with graph_bfs and with parallel_bfs on 1 to 16 threads.
+// Prints millions of traversed edges per second (edges in the component
+// searched / wall time, as Graph500 counts them) and checks that every
+// search finds the same distances as graph_bfs.
+#define N_SOURCES 8
+#define EDGE_FACTOR 16
+
+double wall_secs(void){
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+void bench(const char *name, struct edge *edges, int n_nodes, long n_edges){
+    struct graph g;
+    if(edges == NULL || !graph_build(&g, n_nodes, edges, n_edges)){
+        exit(1);
+    }
+    free(edges);
+    int *order = (int *)malloc(n_nodes * sizeof(int));
+    int *expect = (int *)malloc(N_SOURCES * (long)n_nodes * sizeof(int));
+    int *dist = (int *)malloc(n_nodes * sizeof(int));
+    int sources[N_SOURCES];
+    double edges_in_comp[N_SOURCES];
+    srand(1);
+    for(int s = 0; s < N_SOURCES; s++){
+        do{
+            sources[s] = (int)(((size_t)rand() * (RAND_MAX + 1u) + rand()) % n_nodes);
+        } while(g.offsets[sources[s] + 1] == g.offsets[sources[s]]);
+    }
+    printf("%-6s %9d nodes %10ld edges  ", name, n_nodes, n_edges);
+
+    double total_edges = 0;
+    double total_secs = 0;
+    for(int s = 0; s < N_SOURCES; s++){
+        int *d = expect + s * (long)n_nodes;
+        double start = wall_secs();
+        int reached = graph_bfs(&g, sources[s], order, d, NULL);
+        total_secs += wall_secs() - start;
+        long links = 0;
+        for(int i = 0; i < reached; i++){
+            links += g.offsets[order[i] + 1] - g.offsets[order[i]];
+        }
+        edges_in_comp[s] = links / 2.0;
+        total_edges += edges_in_comp[s];
+    }
+    printf(" graph_bfs %7.1f", total_edges / total_secs * 1e-6);
+
+    for(int n_threads = 1; n_threads <= 16; n_threads *= 2){
+        int ok = 1;
+        total_secs = 0;
+        for(int s = 0; s < N_SOURCES; s++){
+            double start = wall_secs();
+            parallel_bfs(&g, sources[s], dist, n_threads);
+            total_secs += wall_secs() - start;
+            ok = ok && memcmp(dist, expect + s * (long)n_nodes, n_nodes * sizeof(int)) == 0;
+        }
+        printf("  %2dT %7.1f%s", n_threads, total_edges / total_secs * 1e-6, ok ? "" : " WRONG");
+    }
+    printf("   (MTEPS)\n");
+    free(dist);
+    free(expect);
+    free(order);
+    graph_free(&g);
+}
+
+int main(int argc, char *argv[]){
+    int scale = argc > 1 ? atoi(argv[1]) : 20;
+    if(scale < 2){
+        scale = 2; // the grid needs some edges to start from
+    }
+    long n_edges;
+    struct edge *edges = gen_rmat(scale, EDGE_FACTOR, 1, &n_edges);
+    bench("R-MAT", edges, 1 << scale, n_edges);
+    int side = 1 << (scale / 2);
+    edges = gen_grid(side, side, 1, &n_edges);
+    bench("grid", edges, side * side, n_edges);
+    return 0;
+}
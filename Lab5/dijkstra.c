@@ -0,0 +1,271 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "dijkstra.h"
+
+#define CACHE_LINE 64
+#define RADIX_BUCKETS 65 // one for "equal to the last key", one per bit
+
+struct heap_entry{
+    long long key;
+    int node;
+};
+
+struct dheap{
+    struct heap_entry *entries; // children of entries[i] are entries[4i+1 .. 4i+4]
+    int *pos;                   // where each node is in entries, -1 if not there
+    int size;
+    void *block;                // what malloc returned
+};
+
+static int heap_init(struct dheap *h, int n_nodes){
+    h->block = malloc((n_nodes + 4) * sizeof(struct heap_entry) + CACHE_LINE);
+    h->pos = (int *)malloc(n_nodes * sizeof(int));
+    if(h->block == NULL || h->pos == NULL){
+        free(h->block);
+        free(h->pos);
+        return 0;
+    }
+    // entries[1] starts a cache line, so every group of four children fills
+    // exactly one
+    uintptr_t first = ((uintptr_t)h->block + sizeof(struct heap_entry) + CACHE_LINE - 1) & ~(uintptr_t)(CACHE_LINE - 1);
+    h->entries = (struct heap_entry *)first - 1;
+    for(int v = 0; v < n_nodes; v++){
+        h->pos[v] = -1;
+    }
+    h->size = 0;
+    return 1;
+}
+
+static void heap_free(struct dheap *h){
+    free(h->block);
+    free(h->pos);
+}
+
+static void heap_place(struct dheap *h, int i, struct heap_entry e){
+    h->entries[i] = e;
+    h->pos[e.node] = i;
+}
+
+// e goes to slot i or above it
+static void sift_up(struct dheap *h, int i, struct heap_entry e){
+    while(i > 0){
+        int parent = (i - 1) / 4;
+        if(h->entries[parent].key <= e.key){
+            break;
+        }
+        heap_place(h, i, h->entries[parent]);
+        i = parent;
+    }
+    heap_place(h, i, e);
+}
+
+// e goes to slot i or below it
+static void sift_down(struct dheap *h, int i, struct heap_entry e){
+    while(1){
+        int first = 4 * i + 1;
+        if(first >= h->size){
+            break;
+        }
+        int end = first + 4 < h->size ? first + 4 : h->size;
+        int best = first;
+        for(int c = first + 1; c < end; c++){
+            if(h->entries[c].key < h->entries[best].key){
+                best = c;
+            }
+        }
+        if(h->entries[best].key >= e.key){
+            break;
+        }
+        heap_place(h, i, h->entries[best]);
+        i = best;
+    }
+    heap_place(h, i, e);
+}
+
+// adds node, or moves it up if it is in the heap already (key only ever
+// gets smaller)
+static void heap_push(struct dheap *h, int node, long long key){
+    struct heap_entry e = {key, node};
+    sift_up(h, h->pos[node] < 0 ? h->size++ : h->pos[node], e);
+}
+
+static struct heap_entry heap_pop(struct dheap *h){
+    struct heap_entry top = h->entries[0];
+    h->pos[top.node] = -1;
+    h->size--;
+    if(h->size > 0){
+        sift_down(h, 0, h->entries[h->size]);
+    }
+    return top;
+}
+
+static void init_paths(int n_nodes, int source, long long dist[], int prev[]){
+    for(int v = 0; v < n_nodes; v++){
+        dist[v] = DIJKSTRA_INF;
+    }
+    if(prev != NULL){
+        for(int v = 0; v < n_nodes; v++){
+            prev[v] = -1;
+        }
+    }
+    dist[source] = 0;
+}
+
+int dijkstra(const struct graph *g, int source, int target, long long dist[], int prev[]){
+    struct dheap h;
+    if(!heap_init(&h, g->n_nodes)){
+        printf("Error: Out of memory!\n");
+        return -1;
+    }
+    init_paths(g->n_nodes, source, dist, prev);
+    heap_push(&h, source, 0);
+    int settled = 0;
+    while(h.size > 0){
+        struct heap_entry top = heap_pop(&h);
+        int cur = top.node;
+        settled++;
+        if(cur == target){
+            break;
+        }
+        for(long k = g->offsets[cur]; k < g->offsets[cur + 1]; k++){
+            int next = g->targets[k];
+            long long d = top.key + g->weights[k];
+            if(d < dist[next]){
+                dist[next] = d;
+                if(prev != NULL){
+                    prev[next] = cur;
+                }
+                heap_push(&h, next, d);
+            }
+        }
+    }
+    heap_free(&h);
+    return settled;
+}
+
+/***************************************************************************/
+
+struct radix_heap{
+    struct heap_entry *bucket[RADIX_BUCKETS];
+    int size[RADIX_BUCKETS];
+    int capacity[RADIX_BUCKETS];
+    unsigned long long last; // the last key taken out; no key is smaller
+    long count;
+};
+
+static void radix_init(struct radix_heap *rh){
+    for(int b = 0; b < RADIX_BUCKETS; b++){
+        rh->bucket[b] = NULL;
+        rh->size[b] = 0;
+        rh->capacity[b] = 0;
+    }
+    rh->last = 0;
+    rh->count = 0;
+}
+
+static void radix_free(struct radix_heap *rh){
+    for(int b = 0; b < RADIX_BUCKETS; b++){
+        free(rh->bucket[b]);
+    }
+}
+
+// 0 for keys equal to last, else 1 + the highest bit where they differ
+static int bucket_of(unsigned long long key, unsigned long long last){
+    return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+}
+
+// returns 0 if out of memory
+static int radix_add(struct radix_heap *rh, struct heap_entry e){
+    int b = bucket_of((unsigned long long)e.key, rh->last);
+    if(rh->size[b] == rh->capacity[b]){
+        int capacity = rh->capacity[b] > 0 ? 2 * rh->capacity[b] : 64;
+        struct heap_entry *entries = (struct heap_entry *)realloc(rh->bucket[b], capacity * sizeof(struct heap_entry));
+        if(entries == NULL){
+            return 0;
+        }
+        rh->bucket[b] = entries;
+        rh->capacity[b] = capacity;
+    }
+    rh->bucket[b][rh->size[b]++] = e;
+    return 1;
+}
+
+static int radix_push(struct radix_heap *rh, int node, long long key){
+    struct heap_entry e = {key, node};
+    rh->count++;
+    return radix_add(rh, e);
+}
+
+// Takes out an entry with the smallest key into *e (count > 0). When
+// bucket 0 is empty, the smallest key in the first bucket that is not
+// becomes last, and that bucket's entries all move to lower buckets: they
+// agree with the new last above the bit that put them there.
+static int radix_pop(struct radix_heap *rh, struct heap_entry *e){
+    if(rh->size[0] == 0){
+        int b = 1;
+        while(rh->size[b] == 0){
+            b++;
+        }
+        unsigned long long min = (unsigned long long)rh->bucket[b][0].key;
+        for(int i = 1; i < rh->size[b]; i++){
+            if((unsigned long long)rh->bucket[b][i].key < min){
+                min = (unsigned long long)rh->bucket[b][i].key;
+            }
+        }
+        rh->last = min;
+        int size = rh->size[b];
+        rh->size[b] = 0;
+        for(int i = 0; i < size; i++){
+            if(!radix_add(rh, rh->bucket[b][i])){
+                return 0;
+            }
+        }
+    }
+    rh->count--;
+    *e = rh->bucket[0][--rh->size[0]];
+    return 1;
+}
+
+int dijkstra_radix(const struct graph *g, int source, int target, long long dist[], int prev[]){
+    struct radix_heap rh;
+    radix_init(&rh);
+    init_paths(g->n_nodes, source, dist, prev);
+    int settled = 0;
+    int ok = radix_push(&rh, source, 0);
+    while(ok && rh.count > 0){
+        struct heap_entry top;
+        if(!radix_pop(&rh, &top)){
+            ok = 0;
+            break;
+        }
+        int cur = top.node;
+        if(top.key > dist[cur]){
+            continue; // a shorter path to cur was found after this entry went in
+        }
+        settled++;
+        if(cur == target){
+            break;
+        }
+        for(long k = g->offsets[cur]; k < g->offsets[cur + 1]; k++){
+            int next = g->targets[k];
+            long long d = top.key + g->weights[k];
+            if(d < dist[next]){
+                dist[next] = d;
+                if(prev != NULL){
+                    prev[next] = cur;
+                }
+                if(!radix_push(&rh, next, d)){
+                    ok = 0;
+                    break;
+                }
+            }
+        }
+    }
+    radix_free(&rh);
+    if(!ok){
+        printf("Error: Out of memory!\n");
+        return -1;
+    }
+    return settled;
+}
@@ -0,0 +1,32 @@
+#if !defined(DIJKSTRA)
+#define DIJKSTRA
+
+#include <limits.h>
+#include "graph.h"
+
+// Shortest paths from source, using the weights connect() stored (they must
+// not be negative), in place of dijsktra_slowish in lab5.py. dist[v] gets
+// the length of the shortest path to v, DIJKSTRA_INF if there is none, and
+// prev[v] (if prev is not NULL) the node before v on it, -1 for source and
+// unreached nodes. With target >= 0 the search stops as soon as the
+// distance to target is known; dist and prev are then final only for the
+// nodes settled by that point, which include every node on the path.
+// Returns the number of nodes settled, -1 if out of memory.
+#define DIJKSTRA_INF LLONG_MAX
+
+// Uses a 4-ary heap that knows where every node sits in it, so a shorter
+// path found to a node already in the heap moves that entry up (decrease-key)
+// instead of adding another one. Four children per node make the heap half
+// as deep as a binary one, and the four sit next to each other in memory.
+int dijkstra(const struct graph *g, int source, int target, long long dist[], int prev[]);
+
+// Uses a radix heap instead, which only works because the weights are
+// integers and the smallest distance never goes down: entries are kept in
+// buckets by the highest bit in which they differ from the last distance
+// taken out, and a bucket is only sorted out further when it is reached, so
+// every entry is moved at most 64 times and no comparisons between entries
+// are needed. Shorter paths are added as new entries and outdated ones
+// skipped when they come out.
+int dijkstra_radix(const struct graph *g, int source, int target, long long dist[], int prev[]);
+
+#endif
@@ -0,0 +1,143 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "graph.h"
+#include "graph_gen.h"
+#include "dijkstra.h"
+
+// Shortest paths on square grids with random weights (about the size of a
+// country's road network at the largest). Times full single-source runs
+// from N_SOURCES nodes and N_PAIRS point-to-point queries that stop at the
+// target, with a binary heap that never updates entries (what Python's
+// heapq leads to; written below), dijkstra and dijkstra_radix, and checks
+// that they agree.
+#define N_SOURCES 3
+#define N_PAIRS 20
+
+struct entry{
+    long long key;
+    int node;
+};
+
+// binary heap with an entry per path found, outdated ones skipped
+int dijkstra_binary(const struct graph *g, int source, int target, long long dist[]){
+    struct entry *heap = (struct entry *)malloc((g->n_links + 1) * sizeof(struct entry));
+    for(int v = 0; v < g->n_nodes; v++){
+        dist[v] = DIJKSTRA_INF;
+    }
+    dist[source] = 0;
+    long size = 0;
+    heap[size].key = 0;
+    heap[size].node = source;
+    size++;
+    int settled = 0;
+    while(size > 0){
+        struct entry top = heap[0];
+        struct entry last = heap[--size];
+        long i = 0;
+        while(2 * i + 1 < size){
+            long c = 2 * i + 1;
+            if(c + 1 < size && heap[c + 1].key < heap[c].key){
+                c++;
+            }
+            if(heap[c].key >= last.key){
+                break;
+            }
+            heap[i] = heap[c];
+            i = c;
+        }
+        heap[i] = last;
+        if(top.key > dist[top.node]){
+            continue;
+        }
+        settled++;
+        if(top.node == target){
+            break;
+        }
+        for(long k = g->offsets[top.node]; k < g->offsets[top.node + 1]; k++){
+            int next = g->targets[k];
+            long long d = top.key + g->weights[k];
+            if(d < dist[next]){
+                dist[next] = d;
+                long j = size++;
+                while(j > 0 && heap[(j - 1) / 2].key > d){
+                    heap[j] = heap[(j - 1) / 2];
+                    j = (j - 1) / 2;
+                }
+                heap[j].key = d;
+                heap[j].node = next;
+            }
+        }
+    }
+    free(heap);
+    return settled;
+}
+
+int run(int way, const struct graph *g, int source, int target, long long dist[]){
+    if(way == 0){
+        return dijkstra_binary(g, source, target, dist);
+    }
+    if(way == 1){
+        return dijkstra(g, source, target, dist, NULL);
+    }
+    return dijkstra_radix(g, source, target, dist, NULL);
+}
+
+int main(){
+    const char *names[] = {"binary heap", "4-ary heap", "radix heap"};
+    srand(1);
+    for(int side = 500; side <= 2000; side *= 2){
+        int n = side * side;
+        long n_edges;
+        struct edge *edges = gen_grid(side, side, 1, &n_edges);
+        struct graph g;
+        if(edges == NULL || !graph_build(&g, n, edges, n_edges)){
+            return 1;
+        }
+        free(edges);
+        long long *dist = (long long *)malloc(n * sizeof(long long));
+        long long *expect = (long long *)malloc(n * sizeof(long long));
+        int sources[N_SOURCES];
+        int pairs[N_PAIRS][2];
+        for(int s = 0; s < N_SOURCES; s++){
+            sources[s] = (int)(((size_t)rand() * (RAND_MAX + 1u) + rand()) % n);
+        }
+        for(int p = 0; p < N_PAIRS; p++){
+            pairs[p][0] = (int)(((size_t)rand() * (RAND_MAX + 1u) + rand()) % n);
+            pairs[p][1] = (int)(((size_t)rand() * (RAND_MAX + 1u) + rand()) % n);
+        }
+        long long targets[N_PAIRS];
+        printf("%dx%d grid (%d nodes)\n", side, side, n);
+        for(int way = 0; way < 3; way++){
+            int ok = 1;
+            clock_t start = clock();
+            for(int s = 0; s < N_SOURCES; s++){
+                run(way, &g, sources[s], -1, dist);
+                if(way == 0 && s == 0){
+                    memcpy(expect, dist, n * sizeof(long long));
+                }
+                if(s == 0){
+                    ok = ok && memcmp(dist, expect, n * sizeof(long long)) == 0;
+                }
+            }
+            double t_full = (double)(clock() - start) / CLOCKS_PER_SEC / N_SOURCES;
+            long settled = 0;
+            start = clock();
+            for(int p = 0; p < N_PAIRS; p++){
+                settled += run(way, &g, pairs[p][0], pairs[p][1], dist);
+                if(way == 0){
+                    targets[p] = dist[pairs[p][1]];
+                }
+                ok = ok && dist[pairs[p][1]] == targets[p];
+            }
+            double t_pair = (double)(clock() - start) / CLOCKS_PER_SEC / N_PAIRS;
+            printf("  %-12s all nodes %8.1f ms   one target %8.1f ms (%ld nodes settled)%s\n",
+                   names[way], t_full * 1e3, t_pair * 1e3, settled / N_PAIRS, ok ? "" : "   WRONG");
+        }
+        free(expect);
+        free(dist);
+        graph_free(&g);
+    }
+    return 0;
+}
@@ -0,0 +1,240 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "graph.h"
+
+int graph_build(struct graph *g, int n_nodes, const struct edge edges[], long n_edges){
+    g->n_nodes = n_nodes;
+    g->n_links = 2 * n_edges;
+    g->offsets = (long *)calloc(n_nodes + 1, sizeof(long));
+    g->targets = (int *)malloc(g->n_links * sizeof(int));
+    g->weights = (int *)malloc(g->n_links * sizeof(int));
+    if(g->offsets == NULL || g->targets == NULL || g->weights == NULL){
+        printf("Error: Out of memory!\n");
+        graph_free(g);
+        return 0;
+    }
+    // counting sort of the links by their first node; going through the
+    // edges in order keeps each node's connections in connect() order
+    for(long i = 0; i < n_edges; i++){
+        g->offsets[edges[i].node1 + 1]++;
+        g->offsets[edges[i].node2 + 1]++;
+    }
+    for(int v = 0; v < n_nodes; v++){
+        g->offsets[v + 1] += g->offsets[v];
+    }
+    for(long i = 0; i < n_edges; i++){
+        int a = edges[i].node1;
+        int b = edges[i].node2;
+        long k = g->offsets[a]++;
+        g->targets[k] = b;
+        g->weights[k] = edges[i].weight;
+        k = g->offsets[b]++;
+        g->targets[k] = a;
+        g->weights[k] = edges[i].weight;
+    }
+    // every offset has moved on to where the next node starts
+    for(int v = n_nodes; v > 0; v--){
+        g->offsets[v] = g->offsets[v - 1];
+    }
+    g->offsets[0] = 0;
+    return 1;
+}
+
+void graph_free(struct graph *g){
+    free(g->offsets);
+    free(g->targets);
+    free(g->weights);
+    g->offsets = NULL;
+    g->targets = NULL;
+    g->weights = NULL;
+    g->n_nodes = 0;
+    g->n_links = 0;
+}
+
+int marks_init(struct visit_marks *m, int n_nodes){
+    m->stamp = (unsigned int *)calloc(n_nodes, sizeof(unsigned int));
+    m->epoch = 1; // nothing is stamped 1 yet
+    m->n_nodes = n_nodes;
+    if(m->stamp == NULL){
+        printf("Error: Out of memory!\n");
+        return 0;
+    }
+    return 1;
+}
+
+void marks_free(struct visit_marks *m){
+    free(m->stamp);
+    m->stamp = NULL;
+    m->n_nodes = 0;
+}
+
+void marks_next_epoch(struct visit_marks *m){
+    m->epoch++;
+    if(m->epoch == 0){
+        // after 2^32 searches old stamps could look current again
+        memset(m->stamp, 0, m->n_nodes * sizeof(unsigned int));
+        m->epoch = 1;
+    }
+}
+
+int marks_visited(const struct visit_marks *m, int v){
+    return m->stamp[v] == m->epoch;
+}
+
+// The visited marks of one search: a bitset of its own (one bit per node),
+// or the stamps of the caller's marks.
+struct visited{
+    uint64_t *bits;
+    struct visit_marks *marks;
+};
+
+static int start_visits(struct visited *vis, int n_nodes, struct visit_marks *marks){
+    vis->marks = marks;
+    vis->bits = NULL;
+    if(marks != NULL){
+        marks_next_epoch(marks);
+        return 1;
+    }
+    vis->bits = (uint64_t *)calloc((n_nodes + 63) / 64, sizeof(uint64_t));
+    return vis->bits != NULL;
+}
+
+static void end_visits(struct visited *vis){
+    free(vis->bits);
+}
+
+// marks v and returns whether it was marked before; the branch goes the
+// same way for a whole search, so it costs next to nothing
+static int test_and_set(struct visited *vis, int v){
+    if(vis->bits == NULL){
+        unsigned int *stamp = &vis->marks->stamp[v];
+        int was_set = *stamp == vis->marks->epoch;
+        *stamp = vis->marks->epoch;
+        return was_set;
+    }
+    uint64_t mask = (uint64_t)1 << (v & 63);
+    int was_set = (vis->bits[v >> 6] & mask) != 0;
+    vis->bits[v >> 6] |= mask;
+    return was_set;
+}
+
+int graph_bfs(const struct graph *g, int source, int order[], int dist[], struct visit_marks *marks){
+    struct visited visited;
+    if(!start_visits(&visited, g->n_nodes, marks)){
+        printf("Error: Out of memory!\n");
+        return -1;
+    }
+    if(dist != NULL){
+        if(marks == NULL){
+            for(int v = 0; v < g->n_nodes; v++){
+                dist[v] = -1;
+            }
+        }
+        dist[source] = 0;
+    }
+    // Every node goes into the queue at most once, so n_nodes slots are
+    // enough and it never has to wrap around: order[head..tail) is the queue
+    // and order[0..head) what has been popped.
+    int head = 0;
+    int tail = 0;
+    order[tail++] = source;
+    test_and_set(&visited, source);
+    while(head < tail){
+        int cur = order[head++];
+        for(long k = g->offsets[cur]; k < g->offsets[cur + 1]; k++){
+            int next = g->targets[k];
+            if(!test_and_set(&visited, next)){
+                order[tail++] = next;
+                if(dist != NULL){
+                    dist[next] = dist[cur] + 1;
+                }
+            }
+        }
+    }
+    end_visits(&visited);
+    return tail;
+}
+
+int graph_dfs(const struct graph *g, int source, int order[], struct visit_marks *marks){
+    struct visited visited;
+    int have_visited = start_visits(&visited, g->n_nodes, marks);
+    // stack[i] is a node on the current path and edge[i] the next of its
+    // links to look at, just what each level of DFS_rec keeps in its loop
+    int *stack = (int *)malloc(g->n_nodes * sizeof(int));
+    long *edge = (long *)malloc(g->n_nodes * sizeof(long));
+    if(!have_visited || stack == NULL || edge == NULL){
+        printf("Error: Out of memory!\n");
+        if(have_visited){
+            end_visits(&visited);
+        }
+        free(stack);
+        free(edge);
+        return -1;
+    }
+    int count = 0;
+    int top = 0;
+    test_and_set(&visited, source);
+    order[count++] = source;
+    stack[top] = source;
+    edge[top] = g->offsets[source];
+    top++;
+    while(top > 0){
+        int cur = stack[top - 1];
+        long k = edge[top - 1];
+        // skip the links to visited nodes without going back to the loop top
+        while(k < g->offsets[cur + 1] && test_and_set(&visited, g->targets[k])){
+            k++;
+        }
+        if(k == g->offsets[cur + 1]){
+            top--;
+            continue;
+        }
+        int next = g->targets[k];
+        edge[top - 1] = k + 1;
+        order[count++] = next;
+        stack[top] = next;
+        edge[top] = g->offsets[next];
+        top++;
+    }
+    end_visits(&visited);
+    free(stack);
+    free(edge);
+    return count;
+}
+
+int graph_components(const struct graph *g, int comp[]){
+    int *queue = (int *)malloc(g->n_nodes * sizeof(int));
+    if(queue == NULL){
+        printf("Error: Out of memory!\n");
+        return -1;
+    }
+    for(int v = 0; v < g->n_nodes; v++){
+        comp[v] = -1;
+    }
+    // comp doubles as the visited marks
+    int n_comps = 0;
+    for(int start = 0; start < g->n_nodes; start++){
+        if(comp[start] >= 0){
+            continue;
+        }
+        int head = 0;
+        int tail = 0;
+        queue[tail++] = start;
+        comp[start] = n_comps;
+        while(head < tail){
+            int cur = queue[head++];
+            for(long k = g->offsets[cur]; k < g->offsets[cur + 1]; k++){
+                int next = g->targets[k];
+                if(comp[next] < 0){
+                    comp[next] = n_comps;
+                    queue[tail++] = next;
+                }
+            }
+        }
+        n_comps++;
+    }
+    free(queue);
+    return n_comps;
+}
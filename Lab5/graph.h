@@ -0,0 +1,68 @@
+#if !defined(GRAPH)
+#define GRAPH
+
+// The graphs of lab5.py in compressed sparse row form: the connections of
+// node v are targets[offsets[v]] .. targets[offsets[v+1] - 1] (with the
+// matching weights), in the order connect() added them. Three arrays in all
+// instead of an object per node and a dict per connection, and traversals
+// scan them front to back. Visited marks live outside the graph (see
+// visit_marks below), so nothing has to be reset afterwards the way
+// unvisit_all does, and several searches can run on the same graph at once.
+
+// an undirected connection, as made by connect(node1, node2, weight)
+struct edge{
+    int node1;
+    int node2;
+    int weight;
+};
+
+struct graph{
+    int n_nodes;
+    long n_links;  // 2 per edge, one in each direction
+    long *offsets; // n_nodes + 1
+    int *targets;  // n_links
+    int *weights;  // n_links
+};
+
+// nodes are numbered 0 .. n_nodes-1; returns 0 if out of memory
+int graph_build(struct graph *g, int n_nodes, const struct edge edges[], long n_edges);
+void graph_free(struct graph *g);
+
+// Visited marks for searches repeated on the same graph: node v counts as
+// visited iff stamp[v] == epoch, so starting a new search only increments
+// epoch, and the stamps are cleared only when it wraps around. A search
+// then costs time for the part of the graph it reaches, not for all of it.
+// Searches running at the same time each need their own marks.
+struct visit_marks{
+    unsigned int *stamp; // n_nodes
+    unsigned int epoch;
+    int n_nodes;
+};
+
+// returns 0 if out of memory
+int marks_init(struct visit_marks *m, int n_nodes);
+void marks_free(struct visit_marks *m);
+// forgets all marks
+void marks_next_epoch(struct visit_marks *m);
+int marks_visited(const struct visit_marks *m, int v);
+
+// Breadth-first search from source. order gets the nodes reached, in the
+// order BFS and get_all_nodes visit them, and doubles as the queue. dist,
+// if not NULL, gets the number of hops from source. With marks == NULL a
+// bitset is made for the call and dist is -1 where not reached. Otherwise
+// the search starts a new epoch in marks, which afterwards tell what it
+// reached, and only the dist of the nodes reached is written.
+// Returns how many nodes were reached, -1 if out of memory.
+int graph_bfs(const struct graph *g, int source, int order[], int dist[], struct visit_marks *marks);
+
+// Depth-first search visiting the nodes in the order DFS_rec prints them,
+// with an explicit stack instead of recursion. Marks and the return value
+// as above.
+int graph_dfs(const struct graph *g, int source, int order[], struct visit_marks *marks);
+
+// comp[v] = number of the connected component of v, numbered from 0 in the
+// order of their smallest node. Returns the number of components, -1 if out
+// of memory.
+int graph_components(const struct graph *g, int comp[]);
+
+#endif
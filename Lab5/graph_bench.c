@@ -0,0 +1,267 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "graph.h"
+
+// Random graphs with n nodes and DEGREE/2 * n edges. Times BFS as lab5.py
+// does it (a struct per node, q.pop(0), and unvisit_all afterwards; written
+// in C below) against graph_bfs, graph_dfs and graph_components, and checks
+// that the visiting orders match BFS and DFS_rec. Then times N_QUERIES
+// searches from random nodes of a graph made of small components (groups of
+// GROUP nodes), where each search reaches only a few nodes: lab5.py style,
+// graph_bfs with a new bitset per call, and graph_bfs and graph_dfs with
+// visit_marks reused from call to call.
+#define DEGREE 10
+#define OLD_MAX_NODES 100000 // q.pop(0) makes the old BFS quadratic
+#define QUERY_NODES 1000000
+#define GROUP 16
+#define N_QUERIES 20000
+
+struct vertex;
+
+struct connection{
+    struct vertex *node;
+    int weight;
+};
+
+struct vertex{
+    int name;
+    int visited;
+    int n_connections;
+    int capacity;
+    struct connection *connections;
+};
+
+void connect(struct vertex *node1, struct vertex *node2, int weight){
+    struct vertex *ends[2] = {node1, node2};
+    for(int i = 0; i < 2; i++){
+        struct vertex *v = ends[i];
+        if(v->n_connections == v->capacity){
+            v->capacity = v->capacity > 0 ? 2 * v->capacity : 4;
+            v->connections = (struct connection *)realloc(v->connections, v->capacity * sizeof(struct connection));
+        }
+        v->connections[v->n_connections].node = ends[1 - i];
+        v->connections[v->n_connections].weight = weight;
+        v->n_connections++;
+    }
+}
+
+// BFS from lab5.py, filling order
+int old_bfs(struct vertex *node, int order[]){
+    int count = 0;
+    struct vertex **q = (struct vertex **)malloc(sizeof(struct vertex *));
+    int q_len = 1;
+    int q_cap = 1;
+    q[0] = node;
+    node->visited = 1;
+    while(q_len > 0){
+        struct vertex *cur = q[0];
+        memmove(q, q + 1, (q_len - 1) * sizeof(struct vertex *)); // q.pop(0)
+        q_len--;
+        order[count++] = cur->name;
+        for(int i = 0; i < cur->n_connections; i++){
+            struct vertex *next = cur->connections[i].node;
+            if(!next->visited){
+                if(q_len == q_cap){
+                    q_cap *= 2;
+                    q = (struct vertex **)realloc(q, q_cap * sizeof(struct vertex *));
+                }
+                q[q_len++] = next;
+                next->visited = 1;
+            }
+        }
+    }
+    free(q);
+    return count;
+}
+
+// unvisit_all from lab5.py, with a proper queue
+void old_unvisit_all(struct vertex *node, int n_nodes){
+    struct vertex **q = (struct vertex **)malloc(n_nodes * sizeof(struct vertex *));
+    int head = 0;
+    int tail = 0;
+    q[tail++] = node;
+    node->visited = 0;
+    while(head < tail){
+        struct vertex *cur = q[head++];
+        for(int i = 0; i < cur->n_connections; i++){
+            if(cur->connections[i].node->visited){
+                q[tail++] = cur->connections[i].node;
+                cur->connections[i].node->visited = 0;
+            }
+        }
+    }
+    free(q);
+}
+
+void dfs_rec(const struct graph *g, int node, char visited[], int order[], int *count){
+    visited[node] = 1;
+    order[(*count)++] = node;
+    for(long k = g->offsets[node]; k < g->offsets[node + 1]; k++){
+        if(!visited[g->targets[k]]){
+            dfs_rec(g, g->targets[k], visited, order, count);
+        }
+    }
+}
+
+double millis(clock_t start){
+    return (double)(clock() - start) / CLOCKS_PER_SEC * 1e3;
+}
+
+int random_node(int n){
+    return (int)(((size_t)rand() * (RAND_MAX + 1u) + rand()) % n);
+}
+
+void bench_queries(void){
+    int n = QUERY_NODES;
+    long n_edges = (long)n * DEGREE / 2 / 4; // sparse enough to leave some groups split
+    struct edge *edges = (struct edge *)malloc(n_edges * sizeof(struct edge));
+    for(long i = 0; i < n_edges; i++){
+        int group = random_node(n / GROUP) * GROUP;
+        edges[i].node1 = group + rand() % GROUP;
+        edges[i].node2 = group + rand() % GROUP;
+        edges[i].weight = 1;
+    }
+    struct graph g;
+    struct visit_marks marks;
+    if(!graph_build(&g, n, edges, n_edges) || !marks_init(&marks, n)){
+        exit(1);
+    }
+    struct vertex *nodes = (struct vertex *)calloc(n, sizeof(struct vertex));
+    for(int v = 0; v < n; v++){
+        nodes[v].name = v;
+    }
+    for(long i = 0; i < n_edges; i++){
+        connect(&nodes[edges[i].node1], &nodes[edges[i].node2], edges[i].weight);
+    }
+    int *sources = (int *)malloc(N_QUERIES * sizeof(int));
+    for(int q = 0; q < N_QUERIES; q++){
+        sources[q] = random_node(n);
+    }
+    int *order = (int *)malloc(n * sizeof(int));
+    int *expect = (int *)malloc(n * sizeof(int));
+    const char *names[] = {"lab5 BFS", "graph_bfs", "with marks", "DFS marks"};
+    long reached[4] = {0, 0, 0, 0};
+    int ok = 1;
+    printf("\n%d searches in %d nodes, groups of %d   (us per search)\n", N_QUERIES, n, GROUP);
+    for(int way = 0; way < 4; way++){
+        clock_t start = clock();
+        for(int q = 0; q < N_QUERIES; q++){
+            int count;
+            if(way == 0){
+                count = old_bfs(&nodes[sources[q]], order);
+                old_unvisit_all(&nodes[sources[q]], n);
+            }
+            else if(way == 1){
+                count = graph_bfs(&g, sources[q], order, NULL, NULL);
+            }
+            else if(way == 2){
+                count = graph_bfs(&g, sources[q], order, NULL, &marks);
+            }
+            else{
+                count = graph_dfs(&g, sources[q], order, &marks);
+            }
+            reached[way] += count;
+        }
+        double us = millis(start) * 1e3 / N_QUERIES;
+        ok = ok && reached[way] == reached[0];
+        printf("  %-10s %8.2f\n", names[way], us);
+    }
+    // spot check that marks give the same orders as a bitset per call
+    for(int q = 0; q < 100; q++){
+        int count = graph_bfs(&g, sources[q], expect, NULL, NULL);
+        ok = ok && graph_bfs(&g, sources[q], order, NULL, &marks) == count;
+        ok = ok && memcmp(order, expect, count * sizeof(int)) == 0;
+        count = graph_dfs(&g, sources[q], expect, NULL);
+        ok = ok && graph_dfs(&g, sources[q], order, &marks) == count;
+        ok = ok && memcmp(order, expect, count * sizeof(int)) == 0;
+    }
+    printf("  %.1f nodes reached per search%s\n", (double)reached[0] / N_QUERIES, ok ? "" : "   WRONG");
+    free(expect);
+    free(order);
+    free(sources);
+    for(int v = 0; v < n; v++){
+        free(nodes[v].connections);
+    }
+    free(nodes);
+    marks_free(&marks);
+    graph_free(&g);
+    free(edges);
+}
+
+int main(){
+    printf("%9s %10s %10s %10s %10s %12s   (ms)\n", "nodes", "lab5 BFS", "graph_bfs", "graph_dfs", "components", "components#");
+    srand(1);
+    for(int n = 10000; n <= 1000000; n *= 10){
+        long n_edges = (long)n * DEGREE / 2;
+        struct edge *edges = (struct edge *)malloc(n_edges * sizeof(struct edge));
+        for(long i = 0; i < n_edges; i++){
+            edges[i].node1 = (int)(((size_t)rand() * (RAND_MAX + 1u) + rand()) % n);
+            edges[i].node2 = (int)(((size_t)rand() * (RAND_MAX + 1u) + rand()) % n);
+            edges[i].weight = 1 + rand() % 100;
+        }
+        struct graph g;
+        if(!graph_build(&g, n, edges, n_edges)){
+            return 1;
+        }
+        int *order = (int *)malloc(n * sizeof(int));
+        int *expect = (int *)malloc(n * sizeof(int));
+        int *comp = (int *)malloc(n * sizeof(int));
+        int ok = 1;
+
+        printf("%9d", n);
+        int n_old = -1;
+        if(n <= OLD_MAX_NODES){
+            struct vertex *nodes = (struct vertex *)calloc(n, sizeof(struct vertex));
+            for(int v = 0; v < n; v++){
+                nodes[v].name = v;
+            }
+            for(long i = 0; i < n_edges; i++){
+                connect(&nodes[edges[i].node1], &nodes[edges[i].node2], edges[i].weight);
+            }
+            clock_t start = clock();
+            n_old = old_bfs(&nodes[0], expect);
+            old_unvisit_all(&nodes[0], n);
+            printf(" %10.1f", millis(start));
+            for(int v = 0; v < n; v++){
+                free(nodes[v].connections);
+            }
+            free(nodes);
+        }
+        else{
+            printf(" %10s", "-");
+        }
+
+        clock_t start = clock();
+        int n_bfs = graph_bfs(&g, 0, order, NULL, NULL);
+        printf(" %10.1f", millis(start));
+        if(n_old >= 0){
+            ok = ok && n_bfs == n_old && memcmp(order, expect, n_bfs * sizeof(int)) == 0;
+        }
+
+        start = clock();
+        int n_dfs = graph_dfs(&g, 0, order, NULL);
+        printf(" %10.1f", millis(start));
+        ok = ok && n_dfs == n_bfs;
+        if(n <= OLD_MAX_NODES){
+            char *visited = (char *)calloc(n, 1);
+            int count = 0;
+            dfs_rec(&g, 0, visited, expect, &count);
+            ok = ok && count == n_dfs && memcmp(order, expect, n_dfs * sizeof(int)) == 0;
+            free(visited);
+        }
+
+        start = clock();
+        int n_comps = graph_components(&g, comp);
+        printf(" %10.1f %12d%s\n", millis(start), n_comps, ok ? "" : "   WRONG");
+
+        free(comp);
+        free(expect);
+        free(order);
+        graph_free(&g);
+        free(edges);
+    }
+    bench_queries();
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include "graph_gen.h"
+
+// splitmix64: fast, and unlike rand() gives 64 random bits per call
+static uint64_t next_random(uint64_t *state){
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+static int random_weight(uint64_t *state){
+    return 1 + (int)(next_random(state) % GEN_MAX_WEIGHT);
+}
+
+struct edge *gen_rmat(int scale, int edge_factor, unsigned long long seed, long *n_edges){
+    int n = 1 << scale;
+    long m = (long)edge_factor << scale;
+    struct edge *edges = (struct edge *)malloc(m * sizeof(struct edge));
+    int *label = (int *)malloc(n * sizeof(int));
+    if(edges == NULL || label == NULL){
+        printf("Error: Out of memory!\n");
+        free(edges);
+        free(label);
+        return NULL;
+    }
+    uint64_t state = seed;
+    // the quarters are picked by comparing 32 random bits with these
+    const uint64_t a = (uint64_t)(0.57 * 4294967296.0);
+    const uint64_t ab = (uint64_t)(0.76 * 4294967296.0);
+    const uint64_t abc = (uint64_t)(0.95 * 4294967296.0);
+    for(long i = 0; i < m; i++){
+        int row = 0;
+        int col = 0;
+        for(int bit = 0; bit < scale; bit++){
+            uint64_t r = next_random(&state) >> 32;
+            row = 2 * row + (r >= ab);
+            col = 2 * col + ((r >= a && r < ab) || r >= abc);
+        }
+        edges[i].node1 = row;
+        edges[i].node2 = col;
+        edges[i].weight = random_weight(&state);
+    }
+    for(int v = 0; v < n; v++){
+        label[v] = v;
+    }
+    for(int v = n - 1; v > 0; v--){
+        int j = (int)(next_random(&state) % (uint64_t)(v + 1));
+        int temp = label[v];
+        label[v] = label[j];
+        label[j] = temp;
+    }
+    for(long i = 0; i < m; i++){
+        edges[i].node1 = label[edges[i].node1];
+        edges[i].node2 = label[edges[i].node2];
+    }
+    free(label);
+    *n_edges = m;
+    return edges;
+}
+
+struct edge *gen_grid(int rows, int cols, unsigned long long seed, long *n_edges){
+    long m = (long)rows * (cols - 1) + (long)(rows - 1) * cols;
+    struct edge *edges = (struct edge *)malloc(m * sizeof(struct edge));
+    if(edges == NULL){
+        printf("Error: Out of memory!\n");
+        return NULL;
+    }
+    uint64_t state = seed;
+    long i = 0;
+    for(int r = 0; r < rows; r++){
+        for(int c = 0; c < cols; c++){
+            int v = r * cols + c;
+            if(c + 1 < cols){
+                edges[i].node1 = v;
+                edges[i].node2 = v + 1;
+                edges[i].weight = random_weight(&state);
+                i++;
+            }
+            if(r + 1 < rows){
+                edges[i].node1 = v;
+                edges[i].node2 = v + cols;
+                edges[i].weight = random_weight(&state);
+                i++;
+            }
+        }
+    }
+    *n_edges = m;
+    return edges;
+}
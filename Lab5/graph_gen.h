@@ -0,0 +1,23 @@
+#if !defined(GRAPH_GEN)
+#define GRAPH_GEN
+
+#include "graph.h"
+
+// Synthetic graphs for the benchmarks, as edge lists for graph_build. The
+// weights are random in 1..GEN_MAX_WEIGHT and the same seed gives the same
+// graph. Both return a malloc'd array, NULL if out of memory.
+#define GEN_MAX_WEIGHT 100
+
+// R-MAT graph with the Graph500 parameters: 2^scale nodes and
+// edge_factor * 2^scale edges, each placed by picking one of the four
+// quarters of the adjacency matrix scale times over with probabilities
+// 0.57, 0.19, 0.19 and 0.05. A few nodes end up with very many connections,
+// like in social networks. The node numbers are shuffled afterwards so that
+// those nodes are not all at the start.
+struct edge *gen_rmat(int scale, int edge_factor, unsigned long long seed, long *n_edges);
+
+// rows x cols grid, every node connected to the ones to its right and below
+// it: few connections per node and a large diameter, like a road network
+struct edge *gen_grid(int rows, int cols, unsigned long long seed, long *n_edges);
+
+#endif
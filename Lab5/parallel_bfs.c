@@ -0,0 +1,309 @@
+#define _POSIX_C_SOURCE 200112L // pthread barriers
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "parallel_bfs.h"
+
+#define MAX_THREADS 64
+#define TOP_DOWN_CHUNK 64  // frontier nodes a thread takes at a time
+#define BOTTOM_UP_CHUNK 16 // bitset words (64 nodes each) a thread takes at a time
+#define LOCAL_QUEUE 1024   // nodes a thread collects before adding them to the next frontier
+
+struct pbfs{
+    const struct graph *g;
+    int *dist;
+    int n_threads;
+    uint64_t *visited;
+    uint64_t *front;      // the frontier as a bitset, while going bottom-up
+    uint64_t *next_front;
+    int *queue;           // the frontier as a list, while going top-down
+    int *next_queue;
+    long queue_len;
+    long next_len;        // the counters below are updated atomically
+    long next_count;      // nodes found for the next frontier
+    long next_links;      // links out of them
+    long cursor;          // the next piece of work to take
+    long unvisited_links; // links out of nodes not visited yet
+    int level;
+    int bottom_up;
+    int done;
+    pthread_barrier_t barrier;
+    pthread_mutex_t start_lock; // helpers wait for started (or failed) under it
+    pthread_cond_t start_cond;
+    int started;
+    int failed;
+};
+
+struct pbfs_job{
+    struct pbfs *b;
+    int t;
+};
+
+static long degree(const struct graph *g, int v){
+    return g->offsets[v + 1] - g->offsets[v];
+}
+
+static void add_to_next(struct pbfs *b, const int local[], int n){
+    long at = __atomic_fetch_add(&b->next_len, n, __ATOMIC_RELAXED);
+    memcpy(b->next_queue + at, local, n * sizeof(int));
+}
+
+static void top_down(struct pbfs *b){
+    const struct graph *g = b->g;
+    int local[LOCAL_QUEUE];
+    int n_local = 0;
+    long links = 0;
+    while(1){
+        long start = __atomic_fetch_add(&b->cursor, TOP_DOWN_CHUNK, __ATOMIC_RELAXED);
+        if(start >= b->queue_len){
+            break;
+        }
+        long end = start + TOP_DOWN_CHUNK < b->queue_len ? start + TOP_DOWN_CHUNK : b->queue_len;
+        for(long i = start; i < end; i++){
+            int cur = b->queue[i];
+            for(long k = g->offsets[cur]; k < g->offsets[cur + 1]; k++){
+                int next = g->targets[k];
+                uint64_t *word = &b->visited[next >> 6];
+                uint64_t mask = (uint64_t)1 << (next & 63);
+                // a plain load first: most links lead to visited nodes, and
+                // the atomic or is much dearer (and not needed on one thread)
+                if((__atomic_load_n(word, __ATOMIC_RELAXED) & mask) != 0){
+                    continue;
+                }
+                if(b->n_threads == 1){
+                    *word |= mask;
+                }
+                else if((__atomic_fetch_or(word, mask, __ATOMIC_RELAXED) & mask) != 0){
+                    continue;
+                }
+                b->dist[next] = b->level + 1;
+                links += degree(g, next);
+                local[n_local++] = next;
+                if(n_local == LOCAL_QUEUE){
+                    add_to_next(b, local, n_local);
+                    n_local = 0;
+                }
+            }
+        }
+    }
+    add_to_next(b, local, n_local);
+    __atomic_fetch_add(&b->next_links, links, __ATOMIC_RELAXED);
+}
+
+// Each bitset word belongs to one thread in a step, so visited and
+// next_front are written without atomics here.
+static void bottom_up(struct pbfs *b){
+    const struct graph *g = b->g;
+    int n = g->n_nodes;
+    long n_words = (n + 63) / 64;
+    long count = 0;
+    long links = 0;
+    while(1){
+        long start = __atomic_fetch_add(&b->cursor, BOTTOM_UP_CHUNK, __ATOMIC_RELAXED);
+        if(start >= n_words){
+            break;
+        }
+        long end = start + BOTTOM_UP_CHUNK < n_words ? start + BOTTOM_UP_CHUNK : n_words;
+        for(long w = start; w < end; w++){
+            uint64_t unvisited = ~b->visited[w];
+            if(w == n_words - 1 && n % 64 != 0){
+                unvisited &= ((uint64_t)1 << (n % 64)) - 1;
+            }
+            uint64_t found = 0;
+            while(unvisited != 0){
+                int bit = __builtin_ctzll(unvisited);
+                unvisited &= unvisited - 1;
+                int v = (int)(w * 64 + bit);
+                for(long k = g->offsets[v]; k < g->offsets[v + 1]; k++){
+                    int u = g->targets[k];
+                    if((b->front[u >> 6] >> (u & 63)) & 1){
+                        found |= (uint64_t)1 << bit;
+                        b->dist[v] = b->level + 1;
+                        links += degree(g, v);
+                        count++;
+                        break;
+                    }
+                }
+            }
+            b->next_front[w] = found;
+            b->visited[w] |= found;
+        }
+    }
+    __atomic_fetch_add(&b->next_count, count, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&b->next_links, links, __ATOMIC_RELAXED);
+}
+
+// run by one thread between levels, while the others wait
+static void next_level(struct pbfs *b){
+    int n = b->g->n_nodes;
+    long n_words = (n + 63) / 64;
+    long n_next = b->bottom_up ? b->next_count : b->next_len;
+    b->level++;
+    b->unvisited_links -= b->next_links;
+    if(n_next == 0){
+        b->done = 1;
+        return;
+    }
+    if(!b->bottom_up){
+        int *temp = b->queue;
+        b->queue = b->next_queue;
+        b->next_queue = temp;
+        b->queue_len = n_next;
+        if(b->next_links > b->unvisited_links / BFS_ALPHA){
+            memset(b->front, 0, n_words * sizeof(uint64_t));
+            for(long i = 0; i < b->queue_len; i++){
+                int v = b->queue[i];
+                b->front[v >> 6] |= (uint64_t)1 << (v & 63);
+            }
+            b->bottom_up = 1;
+        }
+    }
+    else{
+        uint64_t *temp = b->front;
+        b->front = b->next_front;
+        b->next_front = temp;
+        if(n_next < n / BFS_BETA){
+            b->queue_len = 0;
+            for(long w = 0; w < n_words; w++){
+                for(uint64_t bits = b->front[w]; bits != 0; bits &= bits - 1){
+                    b->queue[b->queue_len++] = (int)(w * 64 + __builtin_ctzll(bits));
+                }
+            }
+            b->bottom_up = 0;
+        }
+    }
+    b->next_len = 0;
+    b->next_count = 0;
+    b->next_links = 0;
+    b->cursor = 0;
+}
+
+static void *bfs_job(void *arg){
+    struct pbfs_job *job = (struct pbfs_job *)arg;
+    struct pbfs *b = job->b;
+    while(1){
+        if(b->bottom_up){
+            bottom_up(b);
+        }
+        else{
+            top_down(b);
+        }
+        pthread_barrier_wait(&b->barrier);
+        if(job->t == 0){
+            next_level(b);
+        }
+        pthread_barrier_wait(&b->barrier);
+        if(b->done){
+            return NULL;
+        }
+    }
+}
+
+// waits until run_bfs knows how many threads there are, then searches
+static void *helper_job(void *arg){
+    struct pbfs_job *job = (struct pbfs_job *)arg;
+    struct pbfs *b = job->b;
+    pthread_mutex_lock(&b->start_lock);
+    while(!b->started && !b->failed){
+        pthread_cond_wait(&b->start_cond, &b->start_lock);
+    }
+    int ok = b->started;
+    pthread_mutex_unlock(&b->start_lock);
+    return ok ? bfs_job(arg) : NULL;
+}
+
+static int run_bfs(struct pbfs *b, int source){
+    const struct graph *g = b->g;
+    long n_words = (g->n_nodes + 63) / 64;
+    for(int v = 0; v < g->n_nodes; v++){
+        b->dist[v] = -1;
+    }
+    b->dist[source] = 0;
+    b->visited[source >> 6] |= (uint64_t)1 << (source & 63);
+    b->queue[0] = source;
+    b->queue_len = 1;
+    b->next_len = 0;
+    b->next_count = 0;
+    b->next_links = 0;
+    b->cursor = 0;
+    b->unvisited_links = g->n_links - degree(g, source);
+    b->level = 0;
+    b->bottom_up = 0;
+    b->done = 0;
+
+    // Thread 0 is the caller. The barrier can only be sized once it is known
+    // how many helpers started, so they wait at a gate until then.
+    struct pbfs_job jobs[MAX_THREADS];
+    pthread_t threads[MAX_THREADS];
+    for(int t = 0; t < b->n_threads; t++){
+        jobs[t].b = b;
+        jobs[t].t = t;
+    }
+    pthread_mutex_init(&b->start_lock, NULL);
+    pthread_cond_init(&b->start_cond, NULL);
+    b->started = 0;
+    b->failed = 0;
+    int n_started = 1;
+    while(n_started < b->n_threads && pthread_create(&threads[n_started], NULL, helper_job, &jobs[n_started]) == 0){
+        n_started++;
+    }
+    // work is handed out in chunks on demand, so fewer threads only means
+    // each takes more of it
+    b->n_threads = n_started;
+    int ok = pthread_barrier_init(&b->barrier, NULL, b->n_threads) == 0;
+    pthread_mutex_lock(&b->start_lock);
+    b->started = ok;
+    b->failed = !ok;
+    pthread_cond_broadcast(&b->start_cond);
+    pthread_mutex_unlock(&b->start_lock);
+    if(ok){
+        bfs_job(&jobs[0]);
+    }
+    for(int t = 1; t < n_started; t++){
+        pthread_join(threads[t], NULL);
+    }
+    if(ok){
+        pthread_barrier_destroy(&b->barrier);
+    }
+    pthread_cond_destroy(&b->start_cond);
+    pthread_mutex_destroy(&b->start_lock);
+    if(!ok){
+        printf("Error: Could not start the search threads!\n");
+        return -1;
+    }
+
+    int reached = 0;
+    for(long w = 0; w < n_words; w++){
+        reached += __builtin_popcountll(b->visited[w]);
+    }
+    return reached;
+}
+
+int parallel_bfs(const struct graph *g, int source, int dist[], int n_threads){
+    int n = g->n_nodes;
+    long n_words = (n + 63) / 64;
+    struct pbfs b;
+    b.g = g;
+    b.dist = dist;
+    b.n_threads = n_threads < 1 ? 1 : n_threads > MAX_THREADS ? MAX_THREADS : n_threads;
+    b.visited = (uint64_t *)calloc(n_words, sizeof(uint64_t));
+    b.front = (uint64_t *)malloc(n_words * sizeof(uint64_t));
+    b.next_front = (uint64_t *)malloc(n_words * sizeof(uint64_t));
+    b.queue = (int *)malloc(n * sizeof(int));
+    b.next_queue = (int *)malloc(n * sizeof(int));
+    int reached = -1;
+    if(b.visited == NULL || b.front == NULL || b.next_front == NULL || b.queue == NULL || b.next_queue == NULL){
+        printf("Error: Out of memory!\n");
+    }
+    else{
+        reached = run_bfs(&b, source);
+    }
+    free(b.visited);
+    free(b.front);
+    free(b.next_front);
+    free(b.queue);
+    free(b.next_queue);
+    return reached;
+}
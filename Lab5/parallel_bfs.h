@@ -0,0 +1,25 @@
+#if !defined(PARALLEL_BFS)
+#define PARALLEL_BFS
+
+#include "graph.h"
+
+// Breadth-first search with n_threads threads, level by level. While the
+// frontier is small the threads share out its nodes and each looks at their
+// links (top-down, like graph_bfs). Once the links out of the frontier
+// outnumber those of the unvisited nodes by BFS_ALPHA times, it goes
+// bottom-up instead: every unvisited node checks its own links for a parent
+// in the frontier and stops at the first one, which skips most of the links
+// of a large frontier. It goes back to top-down when fewer than
+// n_nodes / BFS_BETA nodes are left in the frontier. Visited marks are a
+// bitset set with atomic or, so two threads never both claim a node.
+#define BFS_ALPHA 14
+#define BFS_BETA 24
+
+// dist gets the number of hops from source, -1 where not reached (the same
+// as graph_bfs gives, and the nodes with dist >= 0 are what get_all_nodes
+// returns). Threads that cannot be started are left out and the search runs
+// on those that did. Returns the number of nodes reached, -1 if out of
+// memory or the threads could not be synchronized.
+int parallel_bfs(const struct graph *g, int source, int dist[], int n_threads);
+
+#endif
@@ -69,3 +69,167 @@ void print_grad(struct rgb_img *grad){
     printf("\n");    
     }
 }
+
+
+void point_op_identity(struct point_op *op){
+    for(int c = 0; c < 3; c++){
+        for(int v = 0; v < 256; v++){
+            op->table[c][v] = v;
+        }
+    }
+}
+
+// Composes f after the ops already in op; f's result is clamped to 0..255.
+void point_op_map(struct point_op *op, int (*f)(int value, int col, void *arg), void *arg){
+    for(int c = 0; c < 3; c++){
+        for(int v = 0; v < 256; v++){
+            int r = f(op->table[c][v], c, arg);
+            if(r < 0){
+                r = 0;
+            }
+            if(r > 255){
+                r = 255;
+            }
+            op->table[c][v] = r;
+        }
+    }
+}
+
+static int scale_value(int value, int col, void *arg){
+    (void)col;
+    double v = value * *(double *)arg;
+    // clamp before converting, a double out of int range has no int value
+    if(!(v > 0)){
+        return 0;
+    }
+    return v > 255 ? 255 : (int)v;
+}
+
+static int gamma_value(int value, int col, void *arg){
+    (void)col;
+    return 255 * pow(value / 255.0, *(double *)arg) + 0.5;
+}
+
+static int invert_value(int value, int col, void *arg){
+    (void)col;
+    (void)arg;
+    return 255 - value;
+}
+
+static int threshold_value(int value, int col, void *arg){
+    (void)col;
+    return value >= *(int *)arg ? 255 : 0;
+}
+
+static int clamp_value(int value, int col, void *arg){
+    (void)col;
+    int *range = (int *)arg;
+    return value < range[0] ? range[0] : value > range[1] ? range[1] : value;
+}
+
+void point_op_scale(struct point_op *op, double factor){
+    point_op_map(op, scale_value, &factor);
+}
+
+void point_op_gamma(struct point_op *op, double gamma){
+    point_op_map(op, gamma_value, &gamma);
+}
+
+void point_op_invert(struct point_op *op){
+    point_op_map(op, invert_value, NULL);
+}
+
+void point_op_threshold(struct point_op *op, int level){
+    point_op_map(op, threshold_value, &level);
+}
+
+void point_op_clamp(struct point_op *op, int lo, int hi){
+    int range[2] = {lo, hi};
+    point_op_map(op, clamp_value, range);
+}
+
+// op becomes "op, then next"
+void point_op_compose(struct point_op *op, struct point_op *next){
+    for(int c = 0; c < 3; c++){
+        for(int v = 0; v < 256; v++){
+            op->table[c][v] = next->table[c][op->table[c][v]];
+        }
+    }
+}
+
+// Plain table loads: a 16-round pshufb lookup for 256-entry tables measured
+// slower than this loop, and the tables differ per channel anyway.
+void apply_point_op(struct rgb_img *im, struct point_op *op){
+    apply_point_op_pixels(im->raster, im->height * im->width, op);
+}
+
+void apply_point_op_pixels(uint8_t *raster, size_t n, struct point_op *op){
+    uint8_t *p = raster;
+    size_t i = 0;
+    for(; i + 4 <= n; i += 4, p += 12){
+        p[0] = op->table[0][p[0]];
+        p[1] = op->table[1][p[1]];
+        p[2] = op->table[2][p[2]];
+        p[3] = op->table[0][p[3]];
+        p[4] = op->table[1][p[4]];
+        p[5] = op->table[2][p[5]];
+        p[6] = op->table[0][p[6]];
+        p[7] = op->table[1][p[7]];
+        p[8] = op->table[2][p[8]];
+        p[9] = op->table[0][p[9]];
+        p[10] = op->table[1][p[10]];
+        p[11] = op->table[2][p[11]];
+    }
+    for(; i < n; i++, p += 3){
+        p[0] = op->table[0][p[0]];
+        p[1] = op->table[1][p[1]];
+        p[2] = op->table[2][p[2]];
+    }
+}
+
+
+void grayscale_pixels(uint8_t *raster, size_t n_pixels){
+    uint8_t *p = raster;
+    for(size_t i = 0; i < n_pixels; i++, p += 3){
+        // 0.299 r + 0.587 g + 0.114 b in 8.8 fixed point
+        uint8_t y = (77 * p[0] + 150 * p[1] + 29 * p[2] + 128) >> 8;
+        p[0] = y;
+        p[1] = y;
+        p[2] = y;
+    }
+}
+
+void grayscale(struct rgb_img *im){
+    grayscale_pixels(im->raster, im->height * im->width);
+}
+
+// Dual-gradient energy of one row given the rows above and below it; the
+// left/right neighbours wrap around. out gets energy/10 in all three channels.
+void energy_row(uint8_t *up, uint8_t *row, uint8_t *down, uint8_t *out, size_t width){
+    for(size_t x = 0; x < width; x++){
+        size_t left = x == 0 ? width - 1 : x - 1;
+        size_t right = x == width - 1 ? 0 : x + 1;
+        int sum = 0;
+        for(int c = 0; c < 3; c++){
+            int dx = row[3*right + c] - row[3*left + c];
+            int dy = down[3*x + c] - up[3*x + c];
+            sum += dx*dx + dy*dy;
+        }
+        uint8_t e = (uint8_t)(sqrt(sum) / 10);
+        out[3*x + 0] = e;
+        out[3*x + 1] = e;
+        out[3*x + 2] = e;
+    }
+}
+
+void calc_energy(struct rgb_img *im, struct rgb_img **grad){
+    size_t height = im->height;
+    size_t width = im->width;
+    create_img(grad, height, width);
+    for(size_t y = 0; y < height; y++){
+        size_t up = y == 0 ? height - 1 : y - 1;
+        size_t down = y == height - 1 ? 0 : y + 1;
+        energy_row(im->raster + 3*up*width, im->raster + 3*y*width, im->raster + 3*down*width,
+                   (*grad)->raster + 3*y*width, width);
+    }
+}
@@ -11,6 +11,13 @@ struct rgb_img{
     size_t width;
 };
 
+// A chain of per-channel point operations compiled into one lookup table per
+// channel: applying it costs one pass over the raster however many ops were
+// composed into it.
+struct point_op{
+    uint8_t table[3][256];
+};
+
 void create_img(struct rgb_img **im, size_t height, size_t width);
 void read_in_img(struct rgb_img **im, char *filename);
 void write_img(struct rgb_img *im, char *filename);
@@ -19,5 +26,21 @@ void set_pixel(struct rgb_img *im, int y, int x, int r, int g, int b);
 void destroy_image(struct rgb_img *im);
 void print_grad(struct rgb_img *grad);
 
+void point_op_identity(struct point_op *op);
+void point_op_map(struct point_op *op, int (*f)(int value, int col, void *arg), void *arg);
+void point_op_scale(struct point_op *op, double factor);
+void point_op_gamma(struct point_op *op, double gamma);
+void point_op_invert(struct point_op *op);
+void point_op_threshold(struct point_op *op, int level);
+void point_op_clamp(struct point_op *op, int lo, int hi);
+void point_op_compose(struct point_op *op, struct point_op *next);
+void apply_point_op(struct rgb_img *im, struct point_op *op);
+void apply_point_op_pixels(uint8_t *raster, size_t n_pixels, struct point_op *op);
+
+void grayscale_pixels(uint8_t *raster, size_t n_pixels);
+void grayscale(struct rgb_img *im);
+void energy_row(uint8_t *up, uint8_t *row, uint8_t *down, uint8_t *out, size_t width);
+void calc_energy(struct rgb_img *im, struct rgb_img **grad);
+
 
 #endif
@@ -0,0 +1,121 @@
+#include "img_pipeline.h"
+#include <stdio.h>
+#include <string.h>
+
+#define TILE_BYTES (256 * 1024) // target size of one strip, so two fit in L2
+
+static void point_op_pixels(uint8_t *raster, size_t n_pixels, void *arg){
+    apply_point_op_pixels(raster, n_pixels, (struct point_op *)arg);
+}
+
+static void grayscale_stage(uint8_t *raster, size_t n_pixels, void *arg){
+    (void)arg;
+    grayscale_pixels(raster, n_pixels);
+}
+
+static void energy_rows(uint8_t *in, uint8_t *out, size_t n_rows, size_t width, void *arg){
+    (void)arg;
+    size_t stride = 3 * width;
+    for(size_t y = 0; y < n_rows; y++){
+        energy_row(in + y*stride, in + (y+1)*stride, in + (y+2)*stride, out + y*stride, width);
+    }
+}
+
+void create_pipeline(struct img_pipeline **pl, size_t tile_rows){
+    *pl = (struct img_pipeline *)malloc(sizeof(struct img_pipeline));
+    (*pl)->n_stages = 0;
+    (*pl)->tile_rows = tile_rows;
+}
+
+void pipeline_add_stage(struct img_pipeline *pl, struct img_stage *stage){
+    if(pl->n_stages == MAX_STAGES){
+        printf("Error: Too many pipeline stages!\n");
+        return;
+    }
+    pl->stages[pl->n_stages] = *stage;
+    pl->n_stages++;
+}
+
+void pipeline_add_point_op(struct img_pipeline *pl, struct point_op *op){
+    // back-to-back point ops are folded into a single table
+    if(pl->n_stages > 0 && pl->stages[pl->n_stages - 1].pixels == point_op_pixels){
+        point_op_compose((struct point_op *)pl->stages[pl->n_stages - 1].arg, op);
+        return;
+    }
+    if(pl->n_stages == MAX_STAGES){
+        printf("Error: Too many pipeline stages!\n");
+        return;
+    }
+    pl->ops[pl->n_stages] = *op;
+    struct img_stage stage = {point_op_pixels, NULL, 0, &pl->ops[pl->n_stages]};
+    pipeline_add_stage(pl, &stage);
+}
+
+void pipeline_add_grayscale(struct img_pipeline *pl){
+    struct img_stage stage = {grayscale_stage, NULL, 0, NULL};
+    pipeline_add_stage(pl, &stage);
+}
+
+void pipeline_add_energy(struct img_pipeline *pl){
+    struct img_stage stage = {NULL, energy_rows, 1, NULL};
+    pipeline_add_stage(pl, &stage);
+}
+
+void run_pipeline(struct img_pipeline *pl, struct rgb_img *src, struct rgb_img **dst){
+    size_t height = src->height;
+    size_t width = src->width;
+    size_t stride = 3 * width;
+    create_img(dst, height, width);
+    if(height == 0 || width == 0){
+        return;
+    }
+
+    size_t halo = 0;
+    for(int s = 0; s < pl->n_stages; s++){
+        halo += pl->stages[s].halo;
+    }
+    size_t tile_rows = pl->tile_rows;
+    if(tile_rows == 0){
+        tile_rows = TILE_BYTES / stride;
+    }
+    if(tile_rows == 0){
+        tile_rows = 1;
+    }
+
+    uint8_t *a = (uint8_t *)malloc((tile_rows + 2*halo) * stride);
+    uint8_t *b = (uint8_t *)malloc((tile_rows + 2*halo) * stride);
+    for(size_t y0 = 0; y0 < height; y0 += tile_rows){
+        size_t n = y0 + tile_rows < height ? tile_rows : height - y0;
+        size_t n_rows = n + 2*halo;
+
+        // the strip starts halo rows above y0, wrapping around the image
+        size_t src_row = (y0 + height - halo % height) % height;
+        for(size_t r = 0; r < n_rows; r++){
+            memcpy(a + r*stride, src->raster + src_row*stride, stride);
+            src_row = src_row + 1 == height ? 0 : src_row + 1;
+        }
+
+        uint8_t *cur = a;
+        uint8_t *other = b;
+        for(int s = 0; s < pl->n_stages; s++){
+            struct img_stage *stage = &pl->stages[s];
+            if(stage->pixels != NULL){
+                stage->pixels(cur, n_rows * width, stage->arg);
+            }
+            else{
+                n_rows -= 2 * stage->halo;
+                stage->rows(cur, other, n_rows, width, stage->arg);
+                uint8_t *tmp = cur;
+                cur = other;
+                other = tmp;
+            }
+        }
+        memcpy((*dst)->raster + y0*stride, cur, n * stride);
+    }
+    free(a);
+    free(b);
+}
+
+void destroy_pipeline(struct img_pipeline *pl){
+    free(pl);
+}
@@ -0,0 +1,37 @@
+#if !defined(IMG_PIPELINE)
+#define IMG_PIPELINE
+
+#include "c_img.h"
+
+#define MAX_STAGES 16
+
+// A stage either rewrites pixels in place (pixels != NULL) or computes each
+// row from the rows around it (rows != NULL), in which case it needs `halo`
+// rows of context above and below. Rows above the top/below the bottom of the
+// image wrap around, like calc_energy.
+struct img_stage{
+    void (*pixels)(uint8_t *raster, size_t n_pixels, void *arg);
+    void (*rows)(uint8_t *in, uint8_t *out, size_t n_rows, size_t width, void *arg);
+    int halo;
+    void *arg;
+};
+
+// The image is processed in strips of tile_rows rows (plus halo) that go
+// through every stage while they are still in cache.
+struct img_pipeline{
+    struct img_stage stages[MAX_STAGES];
+    struct point_op ops[MAX_STAGES]; // tables for the point op stages
+    int n_stages;
+    size_t tile_rows;                // 0 means pick from the image width
+};
+
+void create_pipeline(struct img_pipeline **pl, size_t tile_rows);
+void pipeline_add_stage(struct img_pipeline *pl, struct img_stage *stage);
+void pipeline_add_point_op(struct img_pipeline *pl, struct point_op *op);
+void pipeline_add_grayscale(struct img_pipeline *pl);
+void pipeline_add_energy(struct img_pipeline *pl);
+void run_pipeline(struct img_pipeline *pl, struct rgb_img *src, struct rgb_img **dst);
+void destroy_pipeline(struct img_pipeline *pl);
+
+
+#endif
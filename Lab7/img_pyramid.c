@@ -0,0 +1,216 @@
+#include "img_pyramid.h"
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define MAX_THREADS 64
+
+// tmp[i] = rounded average of the 2x2 block made of subpixel i and i+3 (the same
+// channel of the next pixel) in row0 and row1. Only the entries with i % 6 < 3
+// are used, which are then packed into out.
+static void average_row_pair(uint8_t *out, uint8_t *row0, uint8_t *row1, uint8_t *tmp, size_t out_w){
+    size_t n = 6 * out_w - 3; // number of tmp entries we need
+    size_t i = 0;
+#if defined(__SSE2__)
+    __m128i zero = _mm_setzero_si128();
+    __m128i two = _mm_set1_epi16(2);
+    for(; i + 16 <= n; i += 16){
+        __m128i a = _mm_loadu_si128((__m128i *)(row0 + i));
+        __m128i b = _mm_loadu_si128((__m128i *)(row1 + i));
+        __m128i c = _mm_loadu_si128((__m128i *)(row0 + i + 3));
+        __m128i d = _mm_loadu_si128((__m128i *)(row1 + i + 3));
+
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero));
+        lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(c, zero));
+        lo = _mm_add_epi16(lo, _mm_unpacklo_epi8(d, zero));
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, two), 2);
+
+        __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero));
+        hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(c, zero));
+        hi = _mm_add_epi16(hi, _mm_unpackhi_epi8(d, zero));
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, two), 2);
+
+        _mm_storeu_si128((__m128i *)(tmp + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for(; i < n; i++){
+        tmp[i] = (row0[i] + row1[i] + row0[i+3] + row1[i+3] + 2) >> 2;
+    }
+    for(size_t p = 0; p < out_w; p++){
+        out[3*p + 0] = tmp[6*p + 0];
+        out[3*p + 1] = tmp[6*p + 1];
+        out[3*p + 2] = tmp[6*p + 2];
+    }
+}
+
+struct downscale_job{
+    struct rgb_img *src;
+    struct rgb_img *dst;
+    size_t row_start;
+    size_t row_end;
+};
+
+static void *downscale_rows(void *arg){
+    struct downscale_job *job = (struct downscale_job *)arg;
+    size_t src_stride = 3 * job->src->width;
+    size_t dst_stride = 3 * job->dst->width;
+    uint8_t *tmp = (uint8_t *)malloc(6 * job->dst->width);
+    for(size_t y = job->row_start; y < job->row_end; y++){
+        uint8_t *row0 = job->src->raster + (2*y) * src_stride;
+        average_row_pair(job->dst->raster + y * dst_stride, row0, row0 + src_stride, tmp, job->dst->width);
+    }
+    free(tmp);
+    return NULL;
+}
+
+void downscale_2x(struct rgb_img *src, struct rgb_img **dst, int n_threads){
+    // odd rows/columns at the bottom/right edge are dropped
+    create_img(dst, src->height / 2, src->width / 2);
+    size_t height = (*dst)->height;
+    if(height == 0 || (*dst)->width == 0){
+        return;
+    }
+    if(n_threads > MAX_THREADS){
+        n_threads = MAX_THREADS;
+    }
+    if(n_threads > (int)height){
+        n_threads = height;
+    }
+    if(n_threads <= 1){
+        struct downscale_job job = {src, *dst, 0, height};
+        downscale_rows(&job);
+        return;
+    }
+
+    pthread_t threads[MAX_THREADS];
+    struct downscale_job jobs[MAX_THREADS];
+    for(int t = 0; t < n_threads; t++){
+        jobs[t].src = src;
+        jobs[t].dst = *dst;
+        jobs[t].row_start = height * t / n_threads;
+        jobs[t].row_end = height * (t+1) / n_threads;
+        pthread_create(&threads[t], NULL, downscale_rows, &jobs[t]);
+    }
+    for(int t = 0; t < n_threads; t++){
+        pthread_join(threads[t], NULL);
+    }
+}
+
+// For every output index, the range of source indices it covers and the
+// fraction of each one that falls inside it. Returns the weights in a
+// (n_dst * max_taps) array; first[i] and taps[i] describe output index i.
+static float *area_weights(size_t n_src, size_t n_dst, size_t *first, size_t *taps, size_t *max_taps){
+    double scale = (double)n_src / n_dst;
+    *max_taps = (size_t)scale + 2;
+    float *w = (float *)calloc(n_dst * (*max_taps), sizeof(float));
+    for(size_t i = 0; i < n_dst; i++){
+        double lo = i * scale;
+        double hi = (i + 1) * scale;
+        size_t s = (size_t)lo;
+        first[i] = s;
+        taps[i] = 0;
+        for(; s < n_src && s < hi; s++){
+            double a = s > lo ? s : lo;
+            double b = s + 1 < hi ? s + 1 : hi;
+            w[i * (*max_taps) + taps[i]] = (b - a) / scale;
+            taps[i]++;
+        }
+    }
+    return w;
+}
+
+void resize_area(struct rgb_img *src, struct rgb_img **dst, size_t height, size_t width){
+    create_img(dst, height, width);
+    if(height == 0 || width == 0){
+        return;
+    }
+    size_t *x_first = (size_t *)malloc(width * sizeof(size_t));
+    size_t *x_taps = (size_t *)malloc(width * sizeof(size_t));
+    size_t *y_first = (size_t *)malloc(height * sizeof(size_t));
+    size_t *y_taps = (size_t *)malloc(height * sizeof(size_t));
+    size_t x_max, y_max;
+    float *wx = area_weights(src->width, width, x_first, x_taps, &x_max);
+    float *wy = area_weights(src->height, height, y_first, y_taps, &y_max);
+
+    // horizontal pass into a float buffer (src->height rows of the new width),
+    // then a vertical pass into the destination
+    float *tmp = (float *)malloc(src->height * width * 3 * sizeof(float));
+    for(size_t y = 0; y < src->height; y++){
+        uint8_t *row = src->raster + 3 * y * src->width;
+        float *out = tmp + 3 * y * width;
+        for(size_t x = 0; x < width; x++){
+            float r = 0, g = 0, b = 0;
+            for(size_t k = 0; k < x_taps[x]; k++){
+                uint8_t *p = row + 3 * (x_first[x] + k);
+                float w = wx[x * x_max + k];
+                r += w * p[0];
+                g += w * p[1];
+                b += w * p[2];
+            }
+            out[3*x + 0] = r;
+            out[3*x + 1] = g;
+            out[3*x + 2] = b;
+        }
+    }
+
+    for(size_t y = 0; y < height; y++){
+        uint8_t *out = (*dst)->raster + 3 * y * width;
+        for(size_t i = 0; i < 3 * width; i++){
+            float v = 0;
+            for(size_t k = 0; k < y_taps[y]; k++){
+                v += wy[y * y_max + k] * tmp[3 * (y_first[y] + k) * width + i];
+            }
+            v += 0.5f;
+            out[i] = v > 255 ? 255 : (uint8_t)v;
+        }
+    }
+
+    free(tmp);
+    free(wx);
+    free(wy);
+    free(x_first);
+    free(x_taps);
+    free(y_first);
+    free(y_taps);
+}
+
+void create_pyramid(struct img_pyramid **pyr, struct rgb_img *im, int max_levels, int n_threads){
+    // stop once the next level would have no pixels
+    int n_levels = 1;
+    size_t h = im->height;
+    size_t w = im->width;
+    while(n_levels < max_levels && h >= 2 && w >= 2){
+        h /= 2;
+        w /= 2;
+        n_levels++;
+    }
+    *pyr = (struct img_pyramid *)malloc(sizeof(struct img_pyramid));
+    (*pyr)->levels = (struct rgb_img **)calloc(n_levels, sizeof(struct rgb_img *));
+    (*pyr)->levels[0] = im;
+    (*pyr)->n_levels = n_levels;
+    (*pyr)->n_threads = n_threads;
+}
+
+struct rgb_img *get_level(struct img_pyramid *pyr, int level){
+    if(level < 0 || level >= pyr->n_levels){
+        printf("Error: Pyramid level out of Range!\n");
+        return NULL;
+    }
+    if(pyr->levels[level] == NULL){
+        downscale_2x(get_level(pyr, level - 1), &pyr->levels[level], pyr->n_threads);
+    }
+    return pyr->levels[level];
+}
+
+void destroy_pyramid(struct img_pyramid *pyr){
+    for(int i = 1; i < pyr->n_levels; i++){
+        if(pyr->levels[i] != NULL){
+            destroy_image(pyr->levels[i]);
+        }
+    }
+    free(pyr->levels);
+    free(pyr);
+}
@@ -0,0 +1,23 @@
+#if !defined(IMG_PYRAMID)
+#define IMG_PYRAMID
+
+#include "c_img.h"
+
+// levels[0] is the image the pyramid was built from (not owned by the pyramid),
+// levels[i] is levels[i-1] downscaled by 2 in each direction. A level is only
+// computed the first time get_level asks for it.
+struct img_pyramid{
+    struct rgb_img **levels;
+    int n_levels;
+    int n_threads; // <= 1 means downscale on the calling thread only
+};
+
+void create_pyramid(struct img_pyramid **pyr, struct rgb_img *im, int max_levels, int n_threads);
+struct rgb_img *get_level(struct img_pyramid *pyr, int level);
+void destroy_pyramid(struct img_pyramid *pyr);
+
+void downscale_2x(struct rgb_img *src, struct rgb_img **dst, int n_threads);
+void resize_area(struct rgb_img *src, struct rgb_img **dst, size_t height, size_t width);
+
+
+#endif
@@ -0,0 +1,238 @@
+#include "img_stats.h"
+#include <string.h>
+#include <pthread.h>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#define MAX_THREADS 64
+#define N_SUB_HIST 4
+
+struct stats_job{
+    uint8_t *data;   // first subpixel of this job's rows
+    size_t n_pixels;
+    uint64_t count[3][256];
+    uint8_t min[3];
+    uint8_t max[3];
+    uint64_t sum[3];
+};
+
+// Consecutive pixels go to different sub-histograms so that runs of equal
+// values do not wait on the increment of the same counter.
+static void *histogram_job(void *arg){
+    struct stats_job *job = (struct stats_job *)arg;
+    uint32_t (*sub)[3][256] = calloc(N_SUB_HIST, sizeof(*sub));
+    uint8_t *p = job->data;
+    size_t i = 0;
+    for(; i + N_SUB_HIST <= job->n_pixels; i += N_SUB_HIST, p += 3 * N_SUB_HIST){
+        for(int s = 0; s < N_SUB_HIST; s++){
+            sub[s][0][p[3*s + 0]]++;
+            sub[s][1][p[3*s + 1]]++;
+            sub[s][2][p[3*s + 2]]++;
+        }
+    }
+    for(; i < job->n_pixels; i++, p += 3){
+        sub[0][0][p[0]]++;
+        sub[0][1][p[1]]++;
+        sub[0][2][p[2]]++;
+    }
+    memset(job->count, 0, sizeof(job->count));
+    for(int s = 0; s < N_SUB_HIST; s++){
+        for(int c = 0; c < 3; c++){
+            for(int v = 0; v < 256; v++){
+                job->count[c][v] += sub[s][c][v];
+            }
+        }
+    }
+    free(sub);
+    return NULL;
+}
+
+static void *stats_job(void *arg){
+    struct stats_job *job = (struct stats_job *)arg;
+    uint8_t *p = job->data;
+    size_t n = 3 * job->n_pixels;
+    size_t i = 0;
+    for(int c = 0; c < 3; c++){
+        job->min[c] = 255;
+        job->max[c] = 0;
+        job->sum[c] = 0;
+    }
+#if defined(__SSE2__)
+    // 48 bytes = 16 whole pixels, so lane j of register k always holds
+    // channel (16k + j) % 3 and the three registers can be reduced separately.
+    if(n >= 48){
+        __m128i mn[3], mx[3], sum[3][3], mask[3][3];
+        uint8_t m[48];
+        for(int c = 0; c < 3; c++){
+            for(int k = 0; k < 48; k++){
+                m[k] = (k % 3 == c) ? 0xFF : 0;
+            }
+            for(int r = 0; r < 3; r++){
+                mask[r][c] = _mm_loadu_si128((__m128i *)(m + 16*r));
+                sum[r][c] = _mm_setzero_si128();
+            }
+        }
+        for(int r = 0; r < 3; r++){
+            mn[r] = _mm_set1_epi8((char)0xFF);
+            mx[r] = _mm_setzero_si128();
+        }
+        for(; i + 48 <= n; i += 48){
+            for(int r = 0; r < 3; r++){
+                __m128i v = _mm_loadu_si128((__m128i *)(p + i + 16*r));
+                mn[r] = _mm_min_epu8(mn[r], v);
+                mx[r] = _mm_max_epu8(mx[r], v);
+                for(int c = 0; c < 3; c++){
+                    // sad against zero sums the 8-byte halves into two 64-bit lanes
+                    sum[r][c] = _mm_add_epi64(sum[r][c], _mm_sad_epu8(_mm_and_si128(v, mask[r][c]), _mm_setzero_si128()));
+                }
+            }
+        }
+        uint8_t lanes_mn[48], lanes_mx[48];
+        for(int r = 0; r < 3; r++){
+            _mm_storeu_si128((__m128i *)(lanes_mn + 16*r), mn[r]);
+            _mm_storeu_si128((__m128i *)(lanes_mx + 16*r), mx[r]);
+            for(int c = 0; c < 3; c++){
+                uint64_t halves[2];
+                _mm_storeu_si128((__m128i *)halves, sum[r][c]);
+                job->sum[c] += halves[0] + halves[1];
+            }
+        }
+        for(int k = 0; k < 48; k++){
+            if(lanes_mn[k] < job->min[k % 3]){
+                job->min[k % 3] = lanes_mn[k];
+            }
+            if(lanes_mx[k] > job->max[k % 3]){
+                job->max[k % 3] = lanes_mx[k];
+            }
+        }
+    }
+#endif
+    for(; i < n; i++){
+        int c = i % 3;
+        if(p[i] < job->min[c]){
+            job->min[c] = p[i];
+        }
+        if(p[i] > job->max[c]){
+            job->max[c] = p[i];
+        }
+        job->sum[c] += p[i];
+    }
+    return NULL;
+}
+
+// Splits the image into n_threads row bands, runs fun on each and leaves the
+// per-band results in jobs.
+static int run_jobs(struct rgb_img *im, struct stats_job *jobs, int n_threads, void *(*fun)(void *)){
+    size_t height = im->height;
+    if(n_threads > MAX_THREADS){
+        n_threads = MAX_THREADS;
+    }
+    if(n_threads > (int)height){
+        n_threads = height;
+    }
+    if(n_threads < 1){
+        n_threads = 1;
+    }
+    pthread_t threads[MAX_THREADS];
+    for(int t = 0; t < n_threads; t++){
+        size_t start = height * t / n_threads;
+        size_t end = height * (t+1) / n_threads;
+        jobs[t].data = im->raster + 3 * start * im->width;
+        jobs[t].n_pixels = (end - start) * im->width;
+        if(n_threads > 1){
+            pthread_create(&threads[t], NULL, fun, &jobs[t]);
+        }
+        else{
+            fun(&jobs[t]);
+        }
+    }
+    if(n_threads > 1){
+        for(int t = 0; t < n_threads; t++){
+            pthread_join(threads[t], NULL);
+        }
+    }
+    return n_threads;
+}
+
+void img_histogram(struct rgb_img *im, struct img_hist *hist, int n_threads){
+    struct stats_job *jobs = (struct stats_job *)malloc(MAX_THREADS * sizeof(struct stats_job));
+    n_threads = run_jobs(im, jobs, n_threads, histogram_job);
+    memset(hist, 0, sizeof(struct img_hist));
+    for(int t = 0; t < n_threads; t++){
+        for(int c = 0; c < 3; c++){
+            for(int v = 0; v < 256; v++){
+                hist->count[c][v] += jobs[t].count[c][v];
+            }
+        }
+    }
+    free(jobs);
+}
+
+void img_stats(struct rgb_img *im, struct img_stats *stats, int n_threads){
+    struct stats_job *jobs = (struct stats_job *)malloc(MAX_THREADS * sizeof(struct stats_job));
+    n_threads = run_jobs(im, jobs, n_threads, stats_job);
+    uint64_t sum[3] = {0, 0, 0};
+    for(int c = 0; c < 3; c++){
+        stats->min[c] = 255;
+        stats->max[c] = 0;
+    }
+    for(int t = 0; t < n_threads; t++){
+        for(int c = 0; c < 3; c++){
+            if(jobs[t].min[c] < stats->min[c]){
+                stats->min[c] = jobs[t].min[c];
+            }
+            if(jobs[t].max[c] > stats->max[c]){
+                stats->max[c] = jobs[t].max[c];
+            }
+            sum[c] += jobs[t].sum[c];
+        }
+    }
+    size_t n_pixels = im->height * im->width;
+    for(int c = 0; c < 3; c++){
+        stats->mean[c] = n_pixels > 0 ? (double)sum[c] / n_pixels : 0;
+        if(n_pixels == 0){
+            stats->min[c] = 0;
+        }
+    }
+    free(jobs);
+}
+
+void auto_levels(struct rgb_img *im, double clip_fraction, int n_threads){
+    struct img_hist hist;
+    img_histogram(im, &hist, n_threads);
+    uint64_t n_pixels = im->height * im->width;
+    uint64_t clip = (uint64_t)(clip_fraction * n_pixels);
+    struct point_op op;
+
+    for(int c = 0; c < 3; c++){
+        int lo = 0;
+        int hi = 255;
+        uint64_t seen = hist.count[c][0];
+        while(lo < 255 && seen <= clip){
+            lo++;
+            seen += hist.count[c][lo];
+        }
+        seen = hist.count[c][255];
+        while(hi > 0 && seen <= clip){
+            hi--;
+            seen += hist.count[c][hi];
+        }
+        for(int v = 0; v < 256; v++){
+            if(hi <= lo){
+                op.table[c][v] = v; // flat channel, nothing to stretch
+            }
+            else if(v <= lo){
+                op.table[c][v] = 0;
+            }
+            else if(v >= hi){
+                op.table[c][v] = 255;
+            }
+            else{
+                op.table[c][v] = (255 * (v - lo) + (hi - lo) / 2) / (hi - lo);
+            }
+        }
+    }
+
+    apply_point_op(im, &op);
+}
@@ -0,0 +1,25 @@
+#if !defined(IMG_STATS)
+#define IMG_STATS
+
+#include "c_img.h"
+
+struct img_hist{
+    uint64_t count[3][256]; // count[col][v] = number of pixels with value v in channel col
+};
+
+struct img_stats{
+    uint8_t min[3];
+    uint8_t max[3];
+    double mean[3];
+};
+
+// n_threads <= 1 does all the work on the calling thread
+void img_histogram(struct rgb_img *im, struct img_hist *hist, int n_threads);
+void img_stats(struct rgb_img *im, struct img_stats *stats, int n_threads);
+
+// Stretches each channel so that the value below which clip_fraction of the
+// pixels fall maps to 0, and the one above which clip_fraction fall maps to 255.
+void auto_levels(struct rgb_img *im, double clip_fraction, int n_threads);
+
+
+#endif
@@ -10,25 +10,10 @@ int main (void){
     for(int i = 0; i < 5; i++){
        
         read_in_img(&im, "president.bin");
-        for (int j = 0; j< im->height; j++){
-            for (int k = 0; k < im->width; k++){
-                double r = im->raster[3 * (j*(im->width) + k) + 0] * weights[i];
-                double g = im->raster[3 * (j*(im->width) + k) + 1] * weights[i];
-                double b = im->raster[3 * (j*(im->width) + k) + 2] * weights[i];
-                if (r > 255){
-                    r = 255;
-                }
-                if ( g > 255){
-                    g = 255;
-                }
-                if(b > 255){
-                    b = 255;
-                }
-
-                set_pixel(im, j, k, r,g ,b );
-            }
-        
-        }
+        struct point_op op;
+        point_op_identity(&op);
+        point_op_scale(&op, weights[i]); // clamps to 255 like the old per-pixel loop
+        apply_point_op(im, &op);
         char name[9] = "img"; 
         if(i== 0){
              name[3] = '0'; 
@@ -50,5 +35,6 @@ int main (void){
         name[6] = 'i';
         name[7] = 'n';
         write_img(im, name);
+        destroy_image(im);
     }
 }
\ No newline at end of file
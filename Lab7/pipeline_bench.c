@@ -0,0 +1,59 @@
+#include "img_pipeline.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+// scale -> clamp -> grayscale -> energy on a 50 MP image, once as four full
+// passes over the image and once through the fused pipeline.
+int main(void){
+    size_t height = 5000;
+    size_t width = 10000;
+    struct rgb_img *im;
+    create_img(&im, height, width);
+    unsigned int seed = 12345;
+    for(size_t i = 0; i < 3 * height * width; i++){
+        seed = seed * 1103515245 + 12345;
+        im->raster[i] = seed >> 24;
+    }
+
+    struct point_op scale, clamp;
+    point_op_identity(&scale);
+    point_op_scale(&scale, 1.5);
+    point_op_identity(&clamp);
+    point_op_clamp(&clamp, 16, 235);
+
+    struct rgb_img *copy;
+    create_img(&copy, height, width);
+    memcpy(copy->raster, im->raster, 3 * height * width);
+
+    clock_t start = clock();
+    struct rgb_img *seq;
+    apply_point_op(copy, &scale);
+    apply_point_op(copy, &clamp);
+    grayscale(copy);
+    calc_energy(copy, &seq);
+    double t_seq = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    struct img_pipeline *pl;
+    create_pipeline(&pl, 0);
+    pipeline_add_point_op(pl, &scale);
+    pipeline_add_point_op(pl, &clamp);
+    pipeline_add_grayscale(pl);
+    pipeline_add_energy(pl);
+
+    start = clock();
+    struct rgb_img *fused;
+    run_pipeline(pl, im, &fused);
+    double t_fused = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("sequential passes: %.3f s\n", t_seq);
+    printf("fused pipeline:    %.3f s (%d stages)\n", t_fused, pl->n_stages);
+    printf("results %s\n", memcmp(seq->raster, fused->raster, 3 * height * width) == 0 ? "match" : "DIFFER");
+
+    destroy_pipeline(pl);
+    destroy_image(im);
+    destroy_image(copy);
+    destroy_image(seq);
+    destroy_image(fused);
+    return 0;
+}
@@ -59,6 +59,21 @@ struct bag {
 static
 void avl_destroy(avl_node_t *root);
 
+/* FUNCTION avl_build
+ *    Build a perfectly balanced AVL tree from a sorted array of elements.
+ * Parameters and preconditions:
+ *    elems: an array of n elements, in sorted order
+ *    n: the number of elements in elems
+ *    root: a pointer to where to store the root of the new tree
+ * Return value:
+ *    true if the tree was built; false in case of error with memory allocation
+ * Side-effects:
+ *    memory has been allocated for one node per element and *root is the root
+ *    of the new tree (NULL if n == 0 or in case of error)
+ */
+static
+bool avl_build(const bag_elem_t *elems, size_t n, avl_node_t **root);
+
 /* FUNCTION avl_elems
  *    Fill an array with the elements in a BST, given its root.  Place the
  *    elements in sorted order, starting at the given index, and return the
@@ -265,6 +280,21 @@ bag_t *bag_create(int (*cmp)(bag_elem_t, bag_elem_t))
     return bag;
 }
 
+bag_t *bag_create_sorted(int (*cmp)(bag_elem_t, bag_elem_t),
+                         const bag_elem_t *elems, size_t n)
+{
+    bag_t *bag = bag_create(cmp);
+    if (bag) {
+        if (avl_build(elems, n, &bag->root)) {
+            bag->size = n;
+        } else {
+            free(bag);
+            bag = NULL;
+        }
+    }
+    return bag;
+}
+
 void bag_destroy(bag_t *bag)
 {
     avl_destroy(bag->root);
@@ -324,6 +354,25 @@ void avl_destroy(avl_node_t *root)
     }
 }
 
+bool avl_build(const bag_elem_t *elems, size_t n, avl_node_t **root)
+{
+    size_t mid = n / 2; /* index of the element stored at the root */
+
+    *root = NULL;
+    if (n == 0)
+        return true;
+    if (! (*root = avl_node_create(elems[mid])))
+        return false;
+    if (! avl_build(elems, mid, &(*root)->left) ||
+        ! avl_build(elems + mid + 1, n - mid - 1, &(*root)->right)) {
+        avl_destroy(*root);
+        *root = NULL;
+        return false;
+    }
+    avl_update_height(*root);
+    return true;
+}
+
 size_t avl_elems(const avl_node_t *root, bag_elem_t *array, size_t index)
 {
     size_t count = 0; /* number of elements copied so far */
@@ -36,6 +36,20 @@ typedef struct bag bag_t;
  */
 bag_t *bag_create(int (*cmp)(bag_elem_t, bag_elem_t));
 
+/* FUNCTION bag_create_sorted
+ *    Create a new bag holding the elements of a sorted array, in linear time.
+ * Parameters and preconditions:
+ *    cmp != NULL: pointer to a function for comparing elements (as above)
+ *    elems != NULL: an array of n elements, sorted according to cmp
+ * Return value:
+ *    pointer to a newly-created bag containing every element of elems;
+ *    NULL in case of error with memory allocation
+ * Side-effects:
+ *    memory has been allocated for the new bag and its elements' nodes
+ */
+bag_t *bag_create_sorted(int (*cmp)(bag_elem_t, bag_elem_t),
+                         const bag_elem_t *elems, size_t n);
+
 /* FUNCTION bag_destroy
  *    Free all the memory allocated for a bag.
  * Parameters and preconditions:
@@ -0,0 +1,38 @@
+/* FILE bag_dump.c
+ *    Dump the contents of a bag of floats through a buffered writer.
+ */
+
+/******************************************************************************
+ *  Types and Constants.                                                      *
+ ******************************************************************************/
+
+#include <stdlib.h>
+
+#include "bag_dump.h"
+
+/******************************************************************************
+ *  Definitions of "public" functions -- see header file for documentation.   *
+ ******************************************************************************/
+
+size_t bag_dump_floats(const bag_t *b, struct dump_writer *w)
+{
+    /* bag_traverse gives its function no way to reach the writer, so copy
+     * the (sorted) element pointers out first. */
+    size_t i, n = bag_size(b);
+    bag_elem_t *elems = malloc(n * sizeof(bag_elem_t));
+    if (! elems)
+        return 0;
+
+    n = bag_elems(b, elems);
+    for (i = 0; i < n; ++i) {
+        if (w->binary) {
+            dump_float(w, *(const float *) elems[i]);
+        } else {
+            dump_char(w, ' ');
+            dump_general(w, *(const float *) elems[i]);
+        }
+    }
+
+    free(elems);
+    return n;
+}
@@ -0,0 +1,34 @@
+/* FILE bag_dump.h
+ *    Declarations of functions to dump the contents of a bag of floats through
+ *    the buffered writer from Lab4/dump.h.
+ */
+#ifndef BAG_DUMP_H
+#define BAG_DUMP_H
+
+/******************************************************************************
+ *  Types and Constants.                                                      *
+ ******************************************************************************/
+
+#include "bag.h"
+#include "../Lab4/dump.h"
+
+/******************************************************************************
+ *  Functions, with full documentation.                                       *
+ ******************************************************************************/
+
+/* FUNCTION bag_dump_floats
+ *    Write every element of a bag of floats to a dump writer, in order -- the
+ *    buffered replacement for bag_traverse(b, float_print).
+ * Parameters and preconditions:
+ *    b != NULL: a bag whose elements point to floats
+ *    w != NULL: an open dump writer
+ * Return value:
+ *    the number of elements written
+ * Side-effects:
+ *    in text mode, each element is written as " %g", the same text
+ *    float_print gives; in binary mode, the raw bytes of each float are
+ *    written
+ */
+size_t bag_dump_floats(const bag_t *b, struct dump_writer *w);
+
+#endif/*BAG_DUMP_H*/
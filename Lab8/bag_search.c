@@ -0,0 +1,44 @@
+/* FILE bag_search.c
+ *    Turn bags of ints into sorted arrays for Lab4/search.h.
+ */
+
+/******************************************************************************
+ *  Types and Constants.                                                      *
+ ******************************************************************************/
+
+#include <stdlib.h>
+
+#include "bag_search.h"
+
+/******************************************************************************
+ *  Definitions of "public" functions -- see header file for documentation.   *
+ ******************************************************************************/
+
+size_t bag_int_array(const bag_t *b, int out[])
+{
+    size_t i, n = bag_size(b);
+    bag_elem_t *elems = malloc((n ? n : 1) * sizeof(bag_elem_t));
+    if (! elems)
+        return 0;
+
+    /* bag_elems gives the element pointers in sorted order already. */
+    n = bag_elems(b, elems);
+    for (i = 0; i < n; ++i)
+        out[i] = *(const int *) elems[i];
+
+    free(elems);
+    return n;
+}
+
+bool bag_eytz_build(const bag_t *b, struct eytzinger *e)
+{
+    size_t n = bag_size(b);
+    int *values = malloc((n ? n : 1) * sizeof(int));
+    bool ok = false;
+
+    if (values && bag_int_array(b, values) == n)
+        ok = eytz_build(e, values, n);
+
+    free(values);
+    return ok;
+}
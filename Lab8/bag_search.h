@@ -0,0 +1,48 @@
+/* FILE bag_search.h
+ *    Declarations of functions to turn a bag of ints into the sorted arrays
+ *    searched by Lab4/search.h.
+ */
+#ifndef BAG_SEARCH_H
+#define BAG_SEARCH_H
+
+/******************************************************************************
+ *  Types and Constants.                                                      *
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "bag.h"
+#include "../Lab4/search.h"
+
+/******************************************************************************
+ *  Functions, with full documentation.                                       *
+ ******************************************************************************/
+
+/* FUNCTION bag_int_array
+ *    Copy the values of a bag of ints into an int array, in sorted order, so
+ *    that they can be searched with search_lower, search_upper and friends.
+ * Parameters and preconditions:
+ *    b != NULL: a bag whose elements point to ints
+ *    out != NULL: room for bag_size(b) ints
+ * Return value:
+ *    the number of ints written; 0 in case of error with memory allocation
+ * Side-effects:
+ *    out[0 .. return value) holds the values of b, in increasing order
+ */
+size_t bag_int_array(const bag_t *b, int out[]);
+
+/* FUNCTION bag_eytz_build
+ *    Build the Eytzinger search layout of the values of a bag of ints.
+ * Parameters and preconditions:
+ *    b != NULL: a bag whose elements point to ints
+ *    e != NULL: the layout to fill
+ * Return value:
+ *    true if e was built; false in case of error with memory allocation
+ * Side-effects:
+ *    memory has been allocated for e, to be released with eytz_free; e is a
+ *    copy and does not follow later changes to b
+ */
+bool bag_eytz_build(const bag_t *b, struct eytzinger *e);
+
+#endif/*BAG_SEARCH_H*/
@@ -0,0 +1,94 @@
+/* FILE bag_snapshot.c
+ *    Save bags to binary snapshot files and load them back.
+ */
+
+/******************************************************************************
+ *  Types and Constants.                                                      *
+ ******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "bag_snapshot.h"
+
+/* CONSTANT BAG_MAGIC -- The tag at the start of every bag snapshot. */
+#define BAG_MAGIC "BAG2"
+
+/******************************************************************************
+ *  Definitions of "public" functions -- see header file for documentation.   *
+ ******************************************************************************/
+
+bool bag_save(const bag_t *b, const char *filename, unsigned int elem_type,
+              size_t elem_size)
+{
+    size_t i, n = bag_size(b);
+    size_t type_size = snapshot_type_size(elem_type);
+    bag_elem_t *elems;
+    char *payload;
+    bool ok = false;
+
+    if (elem_type == SNAPSHOT_MIXED || (type_size && elem_size != type_size))
+        return false;
+
+    elems = malloc((n ? n : 1) * sizeof(bag_elem_t));
+    payload = malloc((n ? n : 1) * elem_size);
+    if (elems && payload) {
+        /* Pack the values the elements point to, in sorted order. */
+        n = bag_elems(b, elems);
+        for (i = 0; i < n; ++i)
+            memcpy(payload + i * elem_size, elems[i], elem_size);
+        ok = snapshot_write(filename, BAG_MAGIC, elem_size, elem_type, n,
+                            payload, n * elem_size);
+    }
+
+    free(elems);
+    free(payload);
+    return ok;
+}
+
+bag_t *bag_load_mem(void *data, size_t len, unsigned int elem_type,
+                    int (*cmp)(bag_elem_t, bag_elem_t))
+{
+    struct snapshot_header header;
+    char *payload = snapshot_payload(data, len, BAG_MAGIC, elem_type, &header);
+    bag_elem_t *elems;
+    bag_t *bag;
+    size_t i;
+
+    if (! payload)
+        return NULL;
+
+    /* The values are stored sorted, so the tree can be built bottom-up from
+     * pointers into the payload without comparing anything. */
+    elems = malloc((header.count ? header.count : 1) * sizeof(bag_elem_t));
+    if (! elems)
+        return NULL;
+    for (i = 0; i < header.count; ++i)
+        elems[i] = payload + i * header.elem_size;
+    bag = bag_create_sorted(cmp, elems, header.count);
+
+    free(elems);
+    return bag;
+}
+
+bag_t *bag_load(const char *filename, unsigned int elem_type,
+                int (*cmp)(bag_elem_t, bag_elem_t), void **storage, size_t *len)
+{
+    bag_t *bag;
+
+    *storage = snapshot_map(filename, len);
+    if (! *storage)
+        return NULL;
+    bag = bag_load_mem(*storage, *len, elem_type, cmp);
+    if (! bag) {
+        snapshot_unmap(*storage, *len);
+        *storage = NULL;
+    }
+    return bag;
+}
+
+void bag_unload(bag_t *b, void *storage, size_t len)
+{
+    bag_destroy(b);
+    snapshot_unmap(storage, len);
+}
@@ -0,0 +1,87 @@
+/* FILE bag_snapshot.h
+ *    Declarations of functions to save bags to binary snapshot files (see
+ *    Lab4/snapshot.h for the format) and to load them back.
+ */
+#ifndef BAG_SNAPSHOT_H
+#define BAG_SNAPSHOT_H
+
+/******************************************************************************
+ *  Types and Constants.                                                      *
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#include "bag.h"
+#include "../Lab4/snapshot.h"
+
+/******************************************************************************
+ *  Functions, with full documentation.                                       *
+ ******************************************************************************/
+
+/* FUNCTION bag_save
+ *    Save the elements of a bag to a file, in sorted order.
+ * Parameters and preconditions:
+ *    b != NULL: a bag whose elements each point to elem_size bytes
+ *    filename != NULL: the name of the file to write
+ *    elem_type: what the elements are -- SNAPSHOT_INT, SNAPSHOT_FLOAT,
+ *        SNAPSHOT_DOUBLE, or a number from SNAPSHOT_USER up for other types
+ *    elem_size > 0: the number of bytes each element points to (the size of
+ *        elem_type for the first three)
+ * Return value:
+ *    true if the file was written; false in case of error
+ * Side-effects:
+ *    the file is created (or overwritten) with a header -- element size and
+ *    type, count and checksum -- followed by the packed element values
+ */
+bool bag_save(const bag_t *b, const char *filename, unsigned int elem_type,
+              size_t elem_size);
+
+/* FUNCTION bag_load_mem
+ *    Create a bag from a snapshot that is already in memory.
+ * Parameters and preconditions:
+ *    data != NULL: the whole snapshot file, 8-byte aligned
+ *    len: the number of bytes in data
+ *    elem_type: the element type the bag was saved with
+ *    cmp != NULL: the comparison function the bag was saved with
+ * Return value:
+ *    pointer to a new bag whose elements point into data;
+ *    NULL if the snapshot is invalid, holds another element type, or in case
+ *    of error with memory allocation
+ * Side-effects:
+ *    memory has been allocated for the new bag; data must stay valid until the
+ *    bag is destroyed
+ */
+bag_t *bag_load_mem(void *data, size_t len, unsigned int elem_type,
+                    int (*cmp)(bag_elem_t, bag_elem_t));
+
+/* FUNCTION bag_load
+ *    Map a snapshot file into memory and create a bag from it.
+ * Parameters and preconditions:
+ *    filename != NULL: the name of the file to read
+ *    elem_type: the element type the bag was saved with
+ *    cmp != NULL: the comparison function the bag was saved with
+ *    storage != NULL, len != NULL: where to store the mapping
+ * Return value:
+ *    pointer to a new bag whose elements point into the mapped file;
+ *    NULL if the snapshot is invalid, holds another element type, or in case
+ *    of error
+ * Side-effects:
+ *    the file is mapped into memory (*storage, *len); release it together with
+ *    the bag using bag_unload
+ */
+bag_t *bag_load(const char *filename, unsigned int elem_type,
+                int (*cmp)(bag_elem_t, bag_elem_t), void **storage, size_t *len);
+
+/* FUNCTION bag_unload
+ *    Destroy a bag created by bag_load and unmap its file.
+ * Parameters and preconditions:
+ *    b != NULL: a bag returned by bag_load
+ *    storage, len: the mapping returned by the same call to bag_load
+ * Return value:  none
+ * Side-effects:
+ *    the bag has been destroyed and the file unmapped
+ */
+void bag_unload(bag_t *b, void *storage, size_t len);
+
+#endif/*BAG_SNAPSHOT_H*/